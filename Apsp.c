@@ -0,0 +1,410 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#if defined( __SSE__ )
+#include <immintrin.h>
+#endif
+
+#include "Apsp.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+#define B APSP_BLOCK
+
+static const char magic[ 8 ] = { 'A', 'I', 'R', 'A', 'P', 'S', 'P', '\0' };
+
+// encabezado del archivo de Apsp_Save(); después vienen len renglones de len flotantes
+typedef struct
+{
+   char magic[ 8 ];
+   uint32_t version;
+   uint32_t len;
+} ApspHeader;
+
+// row[ j ] = min( row[ j ], a + src[ j ] ) para j en [0, B)
+static inline void min_plus_row( float* row, float a, const float* src )
+{
+#if defined( __AVX__ )
+   __m256 va = _mm256_set1_ps( a );
+   for( int j = 0; j < B; j += 8 )
+   {
+      __m256 c = _mm256_load_ps( row + j );
+      __m256 s = _mm256_add_ps( va, _mm256_load_ps( src + j ) );
+      _mm256_store_ps( row + j, _mm256_min_ps( c, s ) );
+   }
+#elif defined( __SSE__ )
+   __m128 va = _mm_set1_ps( a );
+   for( int j = 0; j < B; j += 4 )
+   {
+      __m128 c = _mm_load_ps( row + j );
+      __m128 s = _mm_add_ps( va, _mm_load_ps( src + j ) );
+      _mm_store_ps( row + j, _mm_min_ps( c, s ) );
+   }
+#else
+   for( int j = 0; j < B; ++j )
+   {
+      float s = a + src[ j ];
+      if( s < row[ j ] ) row[ j ] = s;
+   }
+#endif
+}
+
+// Floyd–Warshall restringido a un bloque: C = min( C, A(:,k) + B(k,:) ) para
+// cada k del bloque, en orden. Sirve para el bloque diagonal y para los bloques
+// del renglón y la columna de la ronda, donde C coincide con A o con B. Como
+// los pesos no son negativos, el renglón y la columna k no cambian en el paso k,
+// así que la actualización en el mismo lugar es correcta.
+static void fw_block( float* c, const float* a, const float* b, int stride )
+{
+   for( int k = 0; k < B; ++k )
+   {
+      const float* bk = b + (size_t) k * stride;
+      for( int i = 0; i < B; ++i )
+      {
+         float aik = a[ (size_t) i * stride + k ];
+         if( aik == INFINITY ) continue;
+
+         min_plus_row( c + (size_t) i * stride, aik, bk );
+      }
+   }
+}
+
+// producto min-plus de bloques sin dependencias entre sí: C = min( C, A ⊗ B ).
+// Cada tramo de 8 vectores de un renglón de C se queda en registros mientras se
+// recorren los k, así que por cada k sólo se lee el renglón de B
+static void min_plus_block( float* restrict c, const float* restrict a, const float* restrict b, int stride )
+{
+#if defined( __AVX__ ) || defined( __SSE__ )
+#if defined( __AVX__ )
+   typedef __m256 vec;
+   enum { W = 8 };
+#define VLOAD _mm256_load_ps
+#define VSTORE _mm256_store_ps
+#define VSET1 _mm256_set1_ps
+#define VMINPLUS( c, a, b ) _mm256_min_ps( c, _mm256_add_ps( a, b ) )
+#else
+   typedef __m128 vec;
+   enum { W = 4 };
+#define VLOAD _mm_load_ps
+#define VSTORE _mm_store_ps
+#define VSET1 _mm_set1_ps
+#define VMINPLUS( c, a, b ) _mm_min_ps( c, _mm_add_ps( a, b ) )
+#endif
+   enum { SPAN = 8 * W };
+
+   for( int i = 0; i < B; ++i )
+   {
+      float* ci = c + (size_t) i * stride;
+      const float* ai = a + (size_t) i * stride;
+
+      for( int j = 0; j < B; j += SPAN )
+      {
+         // los ciclos de 8 se desenrollan para que |acc| viva en registros
+         vec acc[ 8 ];
+#pragma GCC unroll 8
+         for( int v = 0; v < 8; ++v ) acc[ v ] = VLOAD( ci + j + v * W );
+
+         for( int k = 0; k < B; ++k )
+         {
+            if( ai[ k ] == INFINITY ) continue;
+
+            vec va = VSET1( ai[ k ] );
+            const float* bk = b + (size_t) k * stride + j;
+#pragma GCC unroll 8
+            for( int v = 0; v < 8; ++v ) acc[ v ] = VMINPLUS( acc[ v ], va, VLOAD( bk + v * W ) );
+         }
+
+#pragma GCC unroll 8
+         for( int v = 0; v < 8; ++v ) VSTORE( ci + j + v * W, acc[ v ] );
+      }
+   }
+#undef VLOAD
+#undef VSTORE
+#undef VSET1
+#undef VMINPLUS
+#else
+   for( int i = 0; i < B; ++i )
+   {
+      float* ci = c + (size_t) i * stride;
+      const float* ai = a + (size_t) i * stride;
+      for( int k = 0; k < B; ++k )
+      {
+         if( ai[ k ] == INFINITY ) continue;
+
+         min_plus_row( ci, ai[ k ], b + (size_t) k * stride );
+      }
+   }
+#endif
+}
+
+typedef struct
+{
+   Apsp* apsp;
+   int id;
+   int threads;
+   pthread_barrier_t* barrier;
+   pthread_mutex_t* launch; ///< se libera cuando ya se sabe cuántos hilos se crearon
+} FwWorker;
+
+static float* block_at( const Apsp* apsp, int bi, int bj )
+{
+   return apsp->dist + (size_t) bi * B * apsp->stride + (size_t) bj * B;
+}
+
+// Floyd–Warshall por bloques. En la ronda kb: (1) el hilo 0 actualiza el
+// bloque diagonal; (2) todos se reparten los bloques del renglón y la columna
+// kb, que sólo dependen del diagonal; (3) todos se reparten los demás
+// bloques, que sólo dependen de los de (2)
+static void* fw_worker( void* arg )
+{
+   FwWorker* w = (FwWorker*) arg;
+   Apsp* apsp = w->apsp;
+   int nb = ( apsp->len + B - 1 ) / B;
+   int stride = apsp->stride;
+
+   for( int kb = 0; kb < nb; ++kb )
+   {
+      float* diag = block_at( apsp, kb, kb );
+
+      if( w->id == 0 ) fw_block( diag, diag, diag, stride );
+      pthread_barrier_wait( w->barrier );
+
+      for( int t = w->id; t < 2 * nb; t += w->threads )
+      {
+         int j = t % nb;
+         if( j == kb ) continue;
+
+         if( t < nb )
+         {
+            float* c = block_at( apsp, kb, j );
+            fw_block( c, diag, c, stride );
+         }
+         else
+         {
+            float* c = block_at( apsp, j, kb );
+            fw_block( c, c, diag, stride );
+         }
+      }
+      pthread_barrier_wait( w->barrier );
+
+      for( int t = w->id; t < nb * nb; t += w->threads )
+      {
+         int bi = t / nb, bj = t % nb;
+         if( bi == kb || bj == kb ) continue;
+
+         min_plus_block( block_at( apsp, bi, bj ), block_at( apsp, bi, kb ), block_at( apsp, kb, bj ), stride );
+      }
+      pthread_barrier_wait( w->barrier );
+   }
+   return NULL;
+}
+
+// punto de entrada de los hilos creados: esperan a que se sepa cuántos hilos
+// hay (y con cuántos se inicializó la barrera) antes de empezar
+static void* fw_thread( void* arg )
+{
+   FwWorker* w = (FwWorker*) arg;
+
+   pthread_mutex_lock( w->launch );
+   pthread_mutex_unlock( w->launch );
+
+   return fw_worker( w );
+}
+
+// reserva una matriz de |len| vértices llena de INFINITY, con 0 en la diagonal
+static Apsp* alloc_matrix( int len )
+{
+   Apsp* apsp = (Apsp*) malloc( sizeof( Apsp ) );
+   if( !apsp ) return NULL;
+
+   // los renglones tienen una línea de caché de más: con una longitud que es
+   // potencia de 2, los renglones de un bloque caerían en los mismos conjuntos del caché
+   int rows = len > 0 ? ( len + B - 1 ) / B * B : B;
+   apsp->len = len;
+   apsp->stride = rows + 16;
+
+   size_t n = (size_t) rows * apsp->stride;
+   apsp->dist = (float*) aligned_alloc( 64, n * sizeof( float ) );
+   if( !apsp->dist )
+   {
+      free( apsp );
+      return NULL;
+   }
+
+   for( size_t i = 0; i < n; ++i ) apsp->dist[ i ] = INFINITY;
+   for( int i = 0; i < rows; ++i ) apsp->dist[ (size_t) i * apsp->stride + i ] = 0.0f;
+
+   return apsp;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Calcula el tiempo mínimo entre todo par de aeropuertos.
+ *
+ * Usa Floyd–Warshall por bloques de APSP_BLOCK x APSP_BLOCK con las operaciones
+ * min-plus vectorizadas (AVX o SSE, según con qué se compile) y reparte los
+ * bloques de cada ronda entre |threads| hilos. El costo es O(V^3) en tiempo y
+ * O(V^2) en memoria, así que está pensada para subredes de unos cuantos miles
+ * de aeropuertos; para consultas aisladas en el grafo completo use Path_Dijkstra().
+ *
+ * @param csr     La copia congelada del grafo. Los pesos no deben ser negativos.
+ * @param threads Número de hilos, incluyendo al que llama. Si no se pueden
+ *                crear todos, se trabaja con los que sí se crearon.
+ *
+ * @return La matriz; NULL si no hubo memoria. Se libera con Apsp_Delete().
+ */
+Apsp* Apsp_New( const CSR* csr, int threads )
+{
+   assert( threads > 0 );
+
+   Apsp* apsp = alloc_matrix( csr->len );
+   if( !apsp ) return NULL;
+
+   for( int u = 0; u < csr->len; ++u )
+   {
+      float* row = apsp->dist + (size_t) u * apsp->stride;
+      const int* targets = CSR_Neighbors( csr, u );
+      const float* weights = CSR_Weights( csr, u );
+
+      for( int k = 0; k < CSR_Degree( csr, u ); ++k )
+      {
+         assert( weights[ k ] >= 0.0f );
+         if( weights[ k ] < row[ targets[ k ] ] ) row[ targets[ k ] ] = weights[ k ];
+      }
+   }
+
+   FwWorker* workers = (FwWorker*) malloc( threads * sizeof( FwWorker ) );
+   pthread_t* tids = (pthread_t*) malloc( threads * sizeof( pthread_t ) );
+   if( !workers || !tids )
+   {
+      free( workers );
+      free( tids );
+      Apsp_Delete( &apsp );
+      return NULL;
+   }
+
+   pthread_barrier_t barrier;
+   pthread_mutex_t launch;
+   pthread_mutex_init( &launch, NULL );
+   pthread_mutex_lock( &launch );
+
+   for( int i = 0; i < threads; ++i )
+   {
+      workers[ i ].apsp = apsp;
+      workers[ i ].id = i;
+      workers[ i ].barrier = &barrier;
+      workers[ i ].launch = &launch;
+   }
+
+   int started = 1;
+   while( started < threads && pthread_create( &tids[ started ], NULL, fw_thread, &workers[ started ] ) == 0 ) ++started;
+
+   // si no se crearon todos los hilos, los bloques se reparten entre los que sí
+   pthread_barrier_init( &barrier, NULL, started );
+   for( int i = 0; i < started; ++i ) workers[ i ].threads = started;
+   pthread_mutex_unlock( &launch );
+
+   fw_worker( &workers[ 0 ] );
+
+   for( int i = 1; i < started; ++i ) pthread_join( tids[ i ], NULL );
+   pthread_barrier_destroy( &barrier );
+   pthread_mutex_destroy( &launch );
+
+   free( workers );
+   free( tids );
+   return apsp;
+}
+
+void Apsp_Delete( Apsp** p_apsp )
+{
+   assert( *p_apsp );
+
+   free( ( *p_apsp )->dist );
+   free( *p_apsp );
+   *p_apsp = NULL;
+}
+
+/**
+ * @brief Guarda la matriz en un archivo binario para reutilizarla con Apsp_Load().
+ *
+ * Se guardan sólo los len x len tiempos (sin relleno), como flotantes en el
+ * orden de bytes de la máquina.
+ *
+ * Se escribe primero a un archivo temporal que luego se renombra, así que un
+ * error a medio escribir no destruye la matriz guardada antes en |path|.
+ *
+ * @return false si hubo un error de escritura.
+ */
+bool Apsp_Save( const Apsp* apsp, const char* path )
+{
+   char tmp[ 4096 ];
+   if( snprintf( tmp, sizeof( tmp ), "%s.tmp", path ) >= (int) sizeof( tmp ) ) return false;
+
+   FILE* f = fopen( tmp, "wb" );
+   if( !f ) return false;
+
+   ApspHeader hdr;
+   memset( &hdr, 0, sizeof( hdr ) );
+   memcpy( hdr.magic, magic, sizeof( magic ) );
+   hdr.version = APSP_VERSION;
+   hdr.len = apsp->len;
+
+   bool ok = fwrite( &hdr, sizeof( hdr ), 1, f ) == 1;
+   for( int i = 0; ok && i < apsp->len; ++i )
+   {
+      ok = fwrite( apsp->dist + (size_t) i * apsp->stride, sizeof( float ), apsp->len, f ) == (size_t) apsp->len;
+   }
+
+   ok = ( fclose( f ) == 0 ) && ok;
+
+   if( ok ) ok = rename( tmp, path ) == 0;
+   if( !ok ) remove( tmp );
+
+   return ok;
+}
+
+/**
+ * @brief Lee una matriz guardada con Apsp_Save().
+ *
+ * @return La matriz; NULL si el archivo no existe, no es de esta versión o está
+ * truncado. El cliente debe verificar que apsp->len coincida con su grafo.
+ */
+Apsp* Apsp_Load( const char* path )
+{
+   FILE* f = fopen( path, "rb" );
+   if( !f ) return NULL;
+
+   ApspHeader hdr;
+   if( fread( &hdr, sizeof( hdr ), 1, f ) != 1 ||
+       memcmp( hdr.magic, magic, sizeof( magic ) ) != 0 ||
+       hdr.version != APSP_VERSION || hdr.len > 0x7fffffff )
+   {
+      fclose( f );
+      return NULL;
+   }
+
+   Apsp* apsp = alloc_matrix( (int) hdr.len );
+
+   bool ok = apsp != NULL;
+   for( int i = 0; ok && i < (int) hdr.len; ++i )
+   {
+      ok = fread( apsp->dist + (size_t) i * apsp->stride, sizeof( float ), hdr.len, f ) == hdr.len;
+   }
+   fclose( f );
+
+   if( !ok && apsp ) Apsp_Delete( &apsp );
+
+   return apsp;
+}
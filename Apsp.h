@@ -0,0 +1,54 @@
+#ifndef  APSP_INC
+#define  APSP_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "CSR.h"
+
+/**
+ * @brief Lado de los bloques en los que se parte la matriz. Tres bloques
+ * (64 x 64 x 4 bytes = 16 KB cada uno) caben en el caché L2.
+ */
+#define APSP_BLOCK 64
+
+/**
+ * @brief Versión del formato de archivo de Apsp_Save().
+ */
+#define APSP_VERSION 1
+
+/**
+ * @brief Matriz densa de tiempos mínimos entre todo par de aeropuertos.
+ *
+ * dist[ i * stride + j ] es el tiempo mínimo de i a j (INFINITY si no hay
+ * camino). La matriz se rellena hasta un múltiplo de APSP_BLOCK renglones y
+ * columnas (más una línea de caché por renglón), y cada renglón empieza alineado
+ * a 64 bytes; el relleno no forma parte del resultado.
+ * Los índices son los mismos que en la copia CSR de la que se construyó.
+ */
+typedef struct
+{
+   int len;      ///< Número de aeropuertos
+   int stride;   ///< Distancia entre renglones, en flotantes
+   float* dist;  ///< renglones de |stride| flotantes
+} Apsp;
+
+Apsp* Apsp_New( const CSR* csr, int threads );
+void Apsp_Delete( Apsp** p_apsp );
+
+bool Apsp_Save( const Apsp* apsp, const char* path );
+Apsp* Apsp_Load( const char* path );
+
+/**
+ * @brief Devuelve el tiempo mínimo de |src| a |dst|; INFINITY si no hay camino.
+ */
+static inline float Apsp_Get( const Apsp* apsp, int src, int dst )
+{
+   assert( 0 <= src && src < apsp->len );
+   assert( 0 <= dst && dst < apsp->len );
+
+   return apsp->dist[ (size_t) src * apsp->stride + dst ];
+}
+
+#endif   /* ----- #ifndef APSP_INC  ----- */
@@ -0,0 +1,438 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Bfs.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// lo que hacen los hilos en una ronda
+enum
+{
+   JOB_CLEAR,     // hops[] = -1 y visited = 0
+   JOB_TOP_DOWN,  // queue -> next_queue
+   JOB_BOTTOM_UP, // front_bits -> next_bits
+   JOB_TO_BITS,   // hops[] == level -> front_bits
+   JOB_TO_QUEUE   // front_bits -> next_queue
+};
+
+// vértices por bloque de la frontera que toma un hilo
+#define QUEUE_CHUNK 64
+
+// palabras de 64 bits (64 vértices cada una) por bloque de un mapa de bits
+#define WORDS_CHUNK 16
+
+// pasa los vértices que el hilo tiene guardados a la siguiente frontera
+static void flush_local( Bfs* bfs, BfsWorker* w )
+{
+   if( w->local_len == 0 ) return;
+
+   int at = atomic_fetch_add_explicit( &bfs->next_len, w->local_len, memory_order_relaxed );
+   memcpy( bfs->next_queue + at, w->local, w->local_len * sizeof( int ) );
+   w->local_len = 0;
+}
+
+static void push_local( Bfs* bfs, BfsWorker* w, int v )
+{
+   w->local[ w->local_len++ ] = v;
+   if( w->local_len == BFS_LOCAL_MAX ) flush_local( bfs, w );
+}
+
+// máscara de los vértices válidos de la palabra |i| (la última puede estar incompleta)
+static uint64_t valid_mask( const Bfs* bfs, int i )
+{
+   int rem = bfs->csr->len - i * 64;
+   return rem >= 64 ? ~(uint64_t) 0 : ( (uint64_t) 1 << rem ) - 1;
+}
+
+static void clear( Bfs* bfs )
+{
+   int i;
+   while( ( i = atomic_fetch_add( &bfs->cursor, WORDS_CHUNK ) ) < bfs->words )
+   {
+      int end = i + WORDS_CHUNK < bfs->words ? i + WORDS_CHUNK : bfs->words;
+      for( int k = i; k < end; ++k ) atomic_store_explicit( &bfs->visited[ k ], 0, memory_order_relaxed );
+
+      int v_end = end * 64 < bfs->csr->len ? end * 64 : bfs->csr->len;
+      for( int v = i * 64; v < v_end; ++v ) bfs->hops[ v ] = -1;
+   }
+}
+
+// cada vértice de la frontera revisa a sus vecinos; el primer hilo que marca a
+// un vecino en |visited| es el que lo agrega a la siguiente frontera
+static void top_down( Bfs* bfs, BfsWorker* w )
+{
+   const CSR* csr = bfs->csr;
+   int next_level = bfs->level + 1;
+
+   int i;
+   while( ( i = atomic_fetch_add( &bfs->cursor, QUEUE_CHUNK ) ) < bfs->queue_len )
+   {
+      int end = i + QUEUE_CHUNK < bfs->queue_len ? i + QUEUE_CHUNK : bfs->queue_len;
+      for( ; i < end; ++i )
+      {
+         int u = bfs->queue[ i ];
+         const int* targets = CSR_Neighbors( csr, u );
+         int degree = CSR_Degree( csr, u );
+         w->edges += degree;
+
+         for( int k = 0; k < degree; ++k )
+         {
+            int v = targets[ k ];
+            uint64_t bit = (uint64_t) 1 << ( v & 63 );
+
+            if( atomic_load_explicit( &bfs->visited[ v >> 6 ], memory_order_relaxed ) & bit ) continue;
+            if( atomic_fetch_or_explicit( &bfs->visited[ v >> 6 ], bit, memory_order_relaxed ) & bit ) continue;
+            // otro hilo lo marcó primero
+
+            bfs->hops[ v ] = next_level;
+            w->degrees += CSR_Degree( csr, v );
+            ++w->found;
+            push_local( bfs, w, v );
+         }
+      }
+   }
+   flush_local( bfs, w );
+}
+
+// cada vértice no visitado busca entre sus aristas de llegada una que venga de
+// la frontera. Cada hilo es dueño de las palabras de su bloque, así que no hay
+// escrituras compartidas
+static void bottom_up( Bfs* bfs, BfsWorker* w )
+{
+   const CSR* csr = bfs->csr;
+   int next_level = bfs->level + 1;
+
+   int i;
+   while( ( i = atomic_fetch_add( &bfs->cursor, WORDS_CHUNK ) ) < bfs->words )
+   {
+      int end = i + WORDS_CHUNK < bfs->words ? i + WORDS_CHUNK : bfs->words;
+      for( ; i < end; ++i )
+      {
+         uint64_t visited = atomic_load_explicit( &bfs->visited[ i ], memory_order_relaxed );
+         uint64_t pending = ~visited & valid_mask( bfs, i );
+         uint64_t next = 0;
+
+         while( pending )
+         {
+            int b = __builtin_ctzll( pending );
+            pending &= pending - 1;
+
+            int v = i * 64 + b;
+            const int* sources = CSR_InNeighbors( csr, v );
+            int degree = CSR_InDegree( csr, v );
+
+            for( int k = 0; k < degree; ++k )
+            {
+               int u = sources[ k ];
+               if( bfs->front_bits[ u >> 6 ] & ( (uint64_t) 1 << ( u & 63 ) ) )
+               {
+                  next |= (uint64_t) 1 << b;
+                  bfs->hops[ v ] = next_level;
+                  w->degrees += CSR_Degree( csr, v );
+                  ++w->found;
+                  w->edges += k + 1;
+                  break;
+               }
+            }
+            if( !( next & ( (uint64_t) 1 << b ) ) ) w->edges += degree;
+         }
+
+         bfs->next_bits[ i ] = next;
+         if( next ) atomic_store_explicit( &bfs->visited[ i ], visited | next, memory_order_relaxed );
+      }
+   }
+}
+
+static void to_bits( Bfs* bfs )
+{
+   int i;
+   while( ( i = atomic_fetch_add( &bfs->cursor, WORDS_CHUNK ) ) < bfs->words )
+   {
+      int end = i + WORDS_CHUNK < bfs->words ? i + WORDS_CHUNK : bfs->words;
+      for( ; i < end; ++i )
+      {
+         uint64_t visited = atomic_load_explicit( &bfs->visited[ i ], memory_order_relaxed );
+         uint64_t bits = 0;
+         for( uint64_t m = visited; m; m &= m - 1 )
+         {
+            int b = __builtin_ctzll( m );
+            if( bfs->hops[ i * 64 + b ] == bfs->level ) bits |= (uint64_t) 1 << b;
+         }
+         bfs->front_bits[ i ] = bits;
+      }
+   }
+}
+
+static void to_queue( Bfs* bfs, BfsWorker* w )
+{
+   int i;
+   while( ( i = atomic_fetch_add( &bfs->cursor, WORDS_CHUNK ) ) < bfs->words )
+   {
+      int end = i + WORDS_CHUNK < bfs->words ? i + WORDS_CHUNK : bfs->words;
+      for( ; i < end; ++i )
+      {
+         for( uint64_t m = bfs->front_bits[ i ]; m; m &= m - 1 )
+         {
+            push_local( bfs, w, i * 64 + __builtin_ctzll( m ) );
+         }
+      }
+   }
+   flush_local( bfs, w );
+}
+
+static void do_job( Bfs* bfs, BfsWorker* w )
+{
+   switch( bfs->job )
+   {
+      case JOB_CLEAR:     clear( bfs ); break;
+      case JOB_TOP_DOWN:  top_down( bfs, w ); break;
+      case JOB_BOTTOM_UP: bottom_up( bfs, w ); break;
+      case JOB_TO_BITS:   to_bits( bfs ); break;
+      case JOB_TO_QUEUE:  to_queue( bfs, w ); break;
+   }
+}
+
+// libera los arreglos y a la búsqueda
+static void free_bfs( Bfs* bfs )
+{
+   free( bfs->workers );
+   free( bfs->tids );
+   free( (void*) bfs->visited );
+   free( bfs->front_bits );
+   free( bfs->next_bits );
+   free( bfs->queue );
+   free( bfs->next_queue );
+   free( bfs );
+}
+
+static void* worker_main( void* arg )
+{
+   BfsWorker* w = (BfsWorker*) arg;
+   Bfs* bfs = w->bfs;
+
+   pthread_mutex_lock( &bfs->launch );
+   pthread_mutex_unlock( &bfs->launch );
+   if( bfs->quit ) return NULL;
+   // no se pudieron crear todos los hilos; las barreras nunca se llenarían
+
+   for( ;; )
+   {
+      pthread_barrier_wait( &bfs->start );
+      if( bfs->quit ) break;
+
+      do_job( bfs, w );
+
+      pthread_barrier_wait( &bfs->done );
+   }
+   return NULL;
+}
+
+// ejecuta una ronda en todos los hilos (el que llama es el hilo 0) y junta sus contadores
+// ret: el número de vértices descubiertos en la ronda
+static int run_job( Bfs* bfs, int job, long* degrees )
+{
+   for( int i = 0; i < bfs->threads; ++i )
+   {
+      BfsWorker* w = &bfs->workers[ i ];
+      w->degrees = w->edges = 0;
+      w->found = 0;
+      w->local_len = 0;
+   }
+   bfs->job = job;
+   atomic_store( &bfs->cursor, 0 );
+   atomic_store( &bfs->next_len, 0 );
+
+   pthread_barrier_wait( &bfs->start );
+   do_job( bfs, &bfs->workers[ 0 ] );
+   pthread_barrier_wait( &bfs->done );
+
+   int found = 0;
+   *degrees = 0;
+   for( int i = 0; i < bfs->threads; ++i )
+   {
+      found += bfs->workers[ i ].found;
+      *degrees += bfs->workers[ i ].degrees;
+      bfs->edges_examined += bfs->workers[ i ].edges;
+   }
+   return found;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Prepara una búsqueda en amplitud con |threads| hilos.
+ *
+ * @param csr     La copia congelada del grafo.
+ * @param threads Número de hilos, incluyendo al que llama a Bfs_Run().
+ *
+ * @return La búsqueda; NULL si no hubo recursos.
+ */
+Bfs* Bfs_New( const CSR* csr, int threads )
+{
+   assert( threads > 0 );
+
+   Bfs* bfs = (Bfs*) calloc( 1, sizeof( Bfs ) );
+   if( !bfs ) return NULL;
+
+   int len = csr->len > 0 ? csr->len : 1;
+
+   bfs->csr = csr;
+   bfs->words = ( len + 63 ) / 64;
+   bfs->threads = threads;
+   bfs->direction_optimizing = true;
+
+   bfs->workers = (BfsWorker*) calloc( threads, sizeof( BfsWorker ) );
+   bfs->tids = (pthread_t*) calloc( threads, sizeof( pthread_t ) );
+   bfs->visited = (_Atomic uint64_t*) calloc( bfs->words, sizeof( uint64_t ) );
+   bfs->front_bits = (uint64_t*) calloc( bfs->words, sizeof( uint64_t ) );
+   bfs->next_bits = (uint64_t*) calloc( bfs->words, sizeof( uint64_t ) );
+   bfs->queue = (int*) malloc( len * sizeof( int ) );
+   bfs->next_queue = (int*) malloc( len * sizeof( int ) );
+
+   if( !bfs->workers || !bfs->tids || !bfs->visited || !bfs->front_bits ||
+       !bfs->next_bits || !bfs->queue || !bfs->next_queue )
+   {
+      free_bfs( bfs );
+      return NULL;
+   }
+
+   pthread_barrier_init( &bfs->start, NULL, threads );
+   pthread_barrier_init( &bfs->done, NULL, threads );
+   atomic_init( &bfs->cursor, 0 );
+   atomic_init( &bfs->next_len, 0 );
+
+   for( int i = 0; i < threads; ++i ) bfs->workers[ i ].bfs = bfs;
+
+   // los hilos no tocan las barreras hasta que se sabe que se crearon todos
+   pthread_mutex_init( &bfs->launch, NULL );
+   pthread_mutex_lock( &bfs->launch );
+
+   int started = 1;
+   while( started < threads && pthread_create( &bfs->tids[ started ], NULL, worker_main, &bfs->workers[ started ] ) == 0 ) ++started;
+
+   bfs->quit = started < threads;
+   pthread_mutex_unlock( &bfs->launch );
+
+   if( bfs->quit )
+   {
+      for( int i = 1; i < started; ++i ) pthread_join( bfs->tids[ i ], NULL );
+
+      pthread_barrier_destroy( &bfs->start );
+      pthread_barrier_destroy( &bfs->done );
+      pthread_mutex_destroy( &bfs->launch );
+      free_bfs( bfs );
+      return NULL;
+   }
+
+   return bfs;
+}
+
+/**
+ * @brief Detiene los hilos y libera la búsqueda.
+ */
+void Bfs_Delete( Bfs** p_bfs )
+{
+   assert( *p_bfs );
+
+   Bfs* bfs = *p_bfs;
+
+   bfs->quit = true;
+   pthread_barrier_wait( &bfs->start );
+   for( int i = 1; i < bfs->threads; ++i ) pthread_join( bfs->tids[ i ], NULL );
+
+   pthread_barrier_destroy( &bfs->start );
+   pthread_barrier_destroy( &bfs->done );
+   pthread_mutex_destroy( &bfs->launch );
+
+   free_bfs( bfs );
+   *p_bfs = NULL;
+}
+
+/**
+ * @brief Calcula el número de conexiones (saltos) desde |src| hasta cada
+ * aeropuerto alcanzable con a lo más |max_hops| saltos.
+ *
+ * @param bfs      La búsqueda.
+ * @param src      Índice del vértice de salida.
+ * @param max_hops Número máximo de saltos; negativo para no tener límite.
+ * @param hops     csr->len entradas: recibe el número de saltos desde |src|, o
+ *                 -1 si el vértice no se alcanzó.
+ *
+ * @return El número de vértices alcanzados, incluyendo a |src|.
+ *
+ * Ejemplo: aeropuertos a los que se llega desde MEX con a lo más 2 conexiones
+ * @code
+   int n = Bfs_Run( bfs, CSR_GetIndexByIata( csr, "MEX" ), 3, hops );
+   @endcode
+ */
+int Bfs_Run( Bfs* bfs, int src, int max_hops, int hops[] )
+{
+   const CSR* csr = bfs->csr;
+   assert( 0 <= src && src < csr->len );
+
+   long degrees;
+
+   bfs->hops = hops;
+   bfs->level = 0;
+   bfs->edges_examined = 0;
+   run_job( bfs, JOB_CLEAR, &degrees );
+
+   hops[ src ] = 0;
+   atomic_store( &bfs->visited[ src >> 6 ], (uint64_t) 1 << ( src & 63 ) );
+   bfs->queue[ 0 ] = src;
+   bfs->queue_len = 1;
+
+   int reached = 1;
+   int frontier = 1;
+   int prev_frontier = 0;
+   long frontier_edges = CSR_Degree( csr, src );
+   long unexplored = csr->edges - frontier_edges;
+   bfs->edges_reached = frontier_edges;
+
+   bool bottom = false;
+   // la frontera vive en queue (arriba hacia abajo) o en front_bits (abajo hacia arriba)
+
+   while( frontier > 0 && ( max_hops < 0 || bfs->level < max_hops ) )
+   {
+      if( !bottom && bfs->direction_optimizing && frontier_edges > unexplored / BFS_ALPHA )
+      {
+         run_job( bfs, JOB_TO_BITS, &degrees );
+         bottom = true;
+      }
+      else if( bottom && frontier < prev_frontier && frontier < csr->len / BFS_BETA )
+      {
+         run_job( bfs, JOB_TO_QUEUE, &degrees );
+         int* tmp = bfs->queue; bfs->queue = bfs->next_queue; bfs->next_queue = tmp;
+         bfs->queue_len = atomic_load( &bfs->next_len );
+         bottom = false;
+      }
+
+      prev_frontier = frontier;
+      if( bottom )
+      {
+         frontier = run_job( bfs, JOB_BOTTOM_UP, &frontier_edges );
+         uint64_t* tmp = bfs->front_bits; bfs->front_bits = bfs->next_bits; bfs->next_bits = tmp;
+      }
+      else
+      {
+         frontier = run_job( bfs, JOB_TOP_DOWN, &frontier_edges );
+         int* tmp = bfs->queue; bfs->queue = bfs->next_queue; bfs->next_queue = tmp;
+         bfs->queue_len = atomic_load( &bfs->next_len );
+      }
+
+      ++bfs->level;
+      reached += frontier;
+      unexplored -= frontier_edges;
+      bfs->edges_reached += frontier_edges;
+   }
+
+   return reached;
+}
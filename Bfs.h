@@ -0,0 +1,97 @@
+#ifndef  BFS_INC
+#define  BFS_INC
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "CSR.h"
+
+/**
+ * @brief Constantes de la heurística de dirección (Beamer et al.): se cambia a
+ * la búsqueda de abajo hacia arriba cuando las aristas que salen de la frontera
+ * son más que 1/BFS_ALPHA de las que faltan por explorar, y se regresa a la de
+ * arriba hacia abajo cuando la frontera tiene menos de 1/BFS_BETA de los vértices.
+ */
+#ifndef BFS_ALPHA
+#define BFS_ALPHA 14
+#endif
+
+#ifndef BFS_BETA
+#define BFS_BETA 24
+#endif
+
+/**
+ * @brief Número de vértices que un hilo junta antes de pasarlos a la siguiente frontera.
+ */
+#define BFS_LOCAL_MAX 256
+
+typedef struct Bfs Bfs;
+
+/**
+ * @brief Memoria de trabajo de un hilo de la búsqueda.
+ */
+typedef struct
+{
+   Bfs* bfs;
+   int local[ BFS_LOCAL_MAX ]; ///< vértices descubiertos que aún no se pasan a la frontera
+   int local_len;
+   long degrees;               ///< suma de los grados de salida de lo descubierto en el nivel
+   long edges;                 ///< aristas revisadas en el nivel
+   int found;                  ///< vértices descubiertos en el nivel
+} BfsWorker;
+
+/**
+ * @brief Búsqueda en amplitud por niveles y en paralelo sobre una copia CSR.
+ *
+ * En cada nivel los hilos se reparten la frontera. Cuando la frontera es chica
+ * cada hilo recorre las aristas que salen de sus vértices (de arriba hacia
+ * abajo); cuando es grande, cada hilo toma un rango de vértices no visitados y
+ * busca entre las aristas que llegan a cada uno (csr->rev_*) alguna que venga de
+ * la frontera (de abajo hacia arriba), y se detiene en la primera. Los vértices
+ * visitados y la frontera se guardan como mapas de bits.
+ *
+ * Los hilos se crean una sola vez, igual que en el servidor, y sólo se
+ * sincronizan entre niveles.
+ */
+struct Bfs
+{
+   const CSR* csr;
+   int words;             ///< número de palabras de 64 bits de cada mapa de bits
+
+   int threads;           ///< número de hilos, incluyendo al que llama
+   BfsWorker* workers;    ///< |threads| entradas
+   pthread_t* tids;       ///< |threads| - 1 entradas
+
+   pthread_mutex_t launch; ///< los hilos esperan aquí a que Bfs_New() termine de crearlos
+   pthread_barrier_t start;
+   pthread_barrier_t done;
+
+   _Atomic uint64_t* visited; ///< un bit por vértice
+   uint64_t* front_bits;      ///< la frontera, cuando se busca de abajo hacia arriba
+   uint64_t* next_bits;
+
+   int* queue;            ///< la frontera, cuando se busca de arriba hacia abajo
+   int queue_len;
+   int* next_queue;
+   atomic_int next_len;
+
+   int* hops;             ///< el resultado de la búsqueda actual
+   int level;             ///< nivel de la frontera actual
+   int job;               ///< lo que deben hacer los hilos en esta ronda
+   atomic_int cursor;     ///< siguiente bloque de trabajo sin asignar
+   bool quit;
+
+   bool direction_optimizing; ///< false: siempre de arriba hacia abajo (para comparar)
+   long edges_examined;       ///< aristas revisadas en la última búsqueda
+   long edges_reached;        ///< aristas que salen de los vértices alcanzados en la última búsqueda
+};
+
+Bfs* Bfs_New( const CSR* csr, int threads );
+void Bfs_Delete( Bfs** p_bfs );
+
+int Bfs_Run( Bfs* bfs, int src, int max_hops, int hops[] );
+
+#endif   /* ----- #ifndef BFS_INC  ----- */
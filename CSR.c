@@ -0,0 +1,532 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include <sys/mman.h>
+
+#if defined( __SSE2__ )
+#include <immintrin.h>
+#endif
+
+#include "CSR.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// los tramos ordenados de a lo más este tamaño se revisan completos con
+// instrucciones vectoriales en lugar de seguir la bisección
+#define LINEAR_MAX 32
+
+// si un arreglo es más de GALLOP_RATIO veces más largo que el otro, la
+// intersección busca cada elemento del corto en el largo en lugar de mezclarlos
+#define GALLOP_RATIO 32
+
+// ret: cuántos elementos de a[0..n) son menores que |key|
+static inline int count_less( const int* a, int n, int key )
+{
+   int k = 0;
+   int i = 0;
+#if defined( __AVX2__ )
+   __m256i vk = _mm256_set1_epi32( key );
+   for( ; i + 8 <= n; i += 8 )
+   {
+      __m256i lt = _mm256_cmpgt_epi32( vk, _mm256_loadu_si256( (const __m256i*)( a + i ) ) );
+      k += __builtin_popcount( _mm256_movemask_ps( _mm256_castsi256_ps( lt ) ) );
+   }
+#elif defined( __SSE2__ )
+   __m128i vk = _mm_set1_epi32( key );
+   for( ; i + 4 <= n; i += 4 )
+   {
+      __m128i lt = _mm_cmpgt_epi32( vk, _mm_loadu_si128( (const __m128i*)( a + i ) ) );
+      k += __builtin_popcount( _mm_movemask_ps( _mm_castsi128_ps( lt ) ) );
+   }
+#endif
+   for( ; i < n; ++i ) k += a[ i ] < key;
+   return k;
+}
+
+// pre: a[0..n) está ordenado
+// ret: la posición del primer elemento >= key; n si no hay
+static int lower_bound( const int* a, int n, int key )
+{
+   int lo = 0;
+   while( n > LINEAR_MAX )
+   {
+      int half = n / 2;
+      if( a[ lo + half ] < key )
+      {
+         lo += half + 1;
+         n -= half + 1;
+      }
+      else
+      {
+         n = half;
+      }
+   }
+   return lo + count_less( a + lo, n, key );
+}
+
+// como lower_bound(), pero con búsqueda exponencial desde el inicio: cuesta
+// O(log p), donde p es la respuesta, y no O(log n)
+static int gallop( const int* a, int n, int key )
+{
+   int hi = 1;
+   while( hi < n && a[ hi - 1 ] < key ) hi *= 2;
+
+   int lo = hi / 2;
+   if( hi > n ) hi = n;
+   return lo + lower_bound( a + lo, hi - lo, key );
+}
+
+// ret: la posición de |key| en el renglón; -1 si no está
+static int find_in_row( const int* row, int n, int key, bool sorted )
+{
+   if( sorted )
+   {
+      int k = lower_bound( row, n, key );
+      return k < n && row[ k ] == key ? k : -1;
+   }
+
+   for( int k = 0; k < n; ++k )
+   {
+      if( row[ k ] == key ) return k;
+   }
+   return -1;
+}
+
+// intersección cuando |a| es mucho más corto que |b|: cada elemento de |a| se
+// busca (búsqueda exponencial) en lo que resta de |b|
+static int intersect_gallop( const int* a, int na, const int* b, int nb, int out[] )
+{
+   int k = 0;
+   for( int i = 0; i < na && nb > 0; ++i )
+   {
+      int p = gallop( b, nb, a[ i ] );
+      b += p;
+      nb -= p;
+
+      if( nb > 0 && b[ 0 ] == a[ i ] )
+      {
+         if( out ) out[ k ] = a[ i ];
+         ++k;
+         ++b;
+         --nb;
+      }
+   }
+   return k;
+}
+
+// intersección por mezcla. Con instrucciones vectoriales se toma un bloque de
+// W elementos de cada arreglo, cada elemento del bloque de |b| se difunde y se
+// compara contra todo el bloque de |a|, y avanza el bloque (o ambos) con el
+// máximo menor. Los elementos de cada arreglo son distintos, así que ningún
+// par se cuenta dos veces
+static int intersect_merge( const int* a, int na, const int* b, int nb, int out[] )
+{
+   int i = 0;
+   int j = 0;
+   int k = 0;
+
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+#if defined( __AVX2__ )
+   enum { W = 8 };
+   typedef __m256i vec;
+#define VLOAD( p ) _mm256_loadu_si256( (const __m256i*)( p ) )
+#define VEQ( x, y ) _mm256_cmpeq_epi32( x, _mm256_set1_epi32( y ) )
+#define VOR _mm256_or_si256
+#define VMASK( x ) _mm256_movemask_ps( _mm256_castsi256_ps( x ) )
+#else
+   enum { W = 4 };
+   typedef __m128i vec;
+#define VLOAD( p ) _mm_loadu_si128( (const __m128i*)( p ) )
+#define VEQ( x, y ) _mm_cmpeq_epi32( x, _mm_set1_epi32( y ) )
+#define VOR _mm_or_si128
+#define VMASK( x ) _mm_movemask_ps( _mm_castsi128_ps( x ) )
+#endif
+
+   while( i + W <= na && j + W <= nb )
+   {
+      vec va = VLOAD( a + i );
+      vec eq = VEQ( va, b[ j ] );
+#pragma GCC unroll 8
+      for( int r = 1; r < W; ++r ) eq = VOR( eq, VEQ( va, b[ j + r ] ) );
+
+      unsigned mask = VMASK( eq );
+      if( out )
+      {
+         for( ; mask; mask &= mask - 1 ) out[ k++ ] = a[ i + __builtin_ctz( mask ) ];
+      }
+      else
+      {
+         k += __builtin_popcount( mask );
+      }
+
+      int a_max = a[ i + W - 1 ];
+      int b_max = b[ j + W - 1 ];
+      if( a_max <= b_max ) i += W;
+      if( b_max <= a_max ) j += W;
+   }
+#undef VLOAD
+#undef VEQ
+#undef VOR
+#undef VMASK
+#endif
+
+   while( i < na && j < nb )
+   {
+      if( a[ i ] < b[ j ] ) ++i;
+      else if( b[ j ] < a[ i ] ) ++j;
+      else
+      {
+         if( out ) out[ k ] = a[ i ];
+         ++k;
+         ++i;
+         ++j;
+      }
+   }
+   return k;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Crea una copia (CSR) de la adyacencia del grafo.
+ *
+ * El grafo original no se modifica y puede seguir usándose; la copia no ve
+ * los cambios posteriores. El orden de los vecinos de cada vértice es el
+ * mismo que el de su lista de vecinos; CSR_Sort() los ordena por índice.
+ *
+ * Los vértices borrados conservan su índice pero quedan sin aristas, y las
+ * aristas que llegaban a ellos no se copian.
+ *
+ * @param g El grafo.
+ *
+ * @return La copia; NULL si no hubo memoria. El cliente la libera con CSR_Delete().
+ */
+CSR* Graph_Freeze( const Graph* g )
+{
+   CSR* csr = (CSR*) calloc( 1, sizeof( CSR ) );
+   if( !csr ) return NULL;
+
+   int n = g->len;
+   csr->len = n;
+   csr->version = g->version;
+
+   // primera pasada: contamos las aristas que salen y que llegan a cada vértice
+   csr->offsets = (int*) calloc( n + 1, sizeof( int ) );
+   csr->rev_offsets = (int*) calloc( n + 1, sizeof( int ) );
+   if( !csr->offsets || !csr->rev_offsets )
+   {
+      CSR_Delete( &csr );
+      return NULL;
+   }
+
+   int edges = 0;
+   for( int i = 0; i < n; ++i )
+   {
+      csr->offsets[ i ] = edges;
+
+      for( List_Iterator it = Vertex_Begin( &g->vertices[ i ] ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+      {
+         int j = List_Iterator_get( it ).index;
+         if( Graph_IsRemoved( g, j ) ) continue;
+         // arista que llegaba a un vértice borrado
+
+         ++edges;
+         ++csr->rev_offsets[ j + 1 ];
+      }
+   }
+   csr->offsets[ n ] = edges;
+   csr->edges = edges;
+
+   for( int i = 0; i < n; ++i ) csr->rev_offsets[ i + 1 ] += csr->rev_offsets[ i ];
+
+   size_t cap = edges > 0 ? edges : 1;
+   csr->targets = (int*) malloc( cap * sizeof( int ) );
+   csr->weights = (float*) malloc( cap * sizeof( float ) );
+   csr->rev_sources = (int*) malloc( cap * sizeof( int ) );
+   csr->rev_weights = (float*) malloc( cap * sizeof( float ) );
+   csr->latitude = (float*) malloc( ( n > 0 ? n : 1 ) * sizeof( float ) );
+   csr->longitude = (float*) malloc( ( n > 0 ? n : 1 ) * sizeof( float ) );
+   csr->data = (Data*) malloc( ( n > 0 ? n : 1 ) * sizeof( Data ) );
+   csr->iata_index = (int*) malloc( IATA_INDEX_SIZE * sizeof( int ) );
+   int* fill = (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+
+   if( !csr->targets || !csr->weights || !csr->rev_sources || !csr->rev_weights ||
+       !csr->latitude || !csr->longitude || !csr->data || !csr->iata_index || !fill )
+   {
+      free( fill );
+      CSR_Delete( &csr );
+      return NULL;
+   }
+
+   // segunda pasada: copiamos las aristas en ambos sentidos
+   for( int i = 0; i < n; ++i ) fill[ i ] = csr->rev_offsets[ i ];
+
+   memcpy( csr->iata_index, g->iata_index, IATA_INDEX_SIZE * sizeof( int ) );
+
+   for( int i = 0; i < n; ++i )
+   {
+      csr->data[ i ] = Graph_GetData( g, i );
+      csr->latitude[ i ] = g->latitudes[ i ];
+      csr->longitude[ i ] = g->longitudes[ i ];
+
+      int k = csr->offsets[ i ];
+
+      for( List_Iterator it = Vertex_Begin( &g->vertices[ i ] ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+      {
+         Edge e = List_Iterator_get( it );
+         if( Graph_IsRemoved( g, e.index ) ) continue;
+
+         csr->targets[ k ] = e.index;
+         csr->weights[ k ] = e.weight;
+
+         csr->rev_sources[ fill[ e.index ] ] = i;
+         csr->rev_weights[ fill[ e.index ] ] = e.weight;
+         ++fill[ e.index ];
+         ++k;
+      }
+   }
+
+   free( fill );
+   return csr;
+}
+
+/**
+ * @brief Libera la copia CSR.
+ *
+ * @param p_csr Referencia a la copia. Al terminar apunta a NULL.
+ */
+void CSR_Delete( CSR** p_csr )
+{
+   assert( *p_csr );
+
+   CSR* csr = *p_csr;
+
+   if( csr->map )
+   {
+      // los arreglos viven en el archivo proyectado
+      munmap( csr->map, csr->map_size );
+      free( csr );
+      *p_csr = NULL;
+      return;
+   }
+
+   free( csr->targets );
+   free( csr->weights );
+   free( csr->offsets );
+   free( csr->rev_sources );
+   free( csr->rev_weights );
+   free( csr->rev_offsets );
+   free( csr->latitude );
+   free( csr->longitude );
+   free( csr->data );
+   free( csr->iata_index );
+   free( csr );
+   *p_csr = NULL;
+}
+
+/**
+ * @brief Cambia el peso de la arista u -> v, en la adyacencia y en la adyacencia
+ * inversa. En un grafo no dirigido la arista v -> u es otra y se cambia aparte.
+ *
+ * Cuesta O(grado de salida de u + grado de entrada de v). No debe llamarse
+ * mientras otros hilos consultan la copia.
+ *
+ * @param csr    La copia. No puede venir de Snapshot_Load() (es de sólo lectura).
+ * @param u      Índice del vértice de salida.
+ * @param v      Índice del vértice de llegada.
+ * @param weight El nuevo peso.
+ *
+ * @return El peso anterior; NAN si la arista no existe.
+ */
+float CSR_SetEdgeWeight( CSR* csr, int u, int v, float weight )
+{
+   assert( !csr->map );
+
+   int k = find_in_row( CSR_Neighbors( csr, u ), CSR_Degree( csr, u ), v, csr->sorted );
+   if( k == -1 ) return NAN;
+
+   float old = csr->weights[ csr->offsets[ u ] + k ];
+   csr->weights[ csr->offsets[ u ] + k ] = weight;
+   ++csr->version;
+
+   int j = find_in_row( CSR_InNeighbors( csr, v ), CSR_InDegree( csr, v ), u, csr->sorted );
+   if( j != -1 ) csr->rev_weights[ csr->rev_offsets[ v ] + j ] = weight;
+
+   return old;
+}
+
+/**
+ * @brief Ordena los vecinos de cada vértice por índice, en la adyacencia y en
+ * la adyacencia inversa (los pesos se mueven junto con su arista).
+ *
+ * Con los renglones ordenados, CSR_HasEdge() y CSR_SetEdgeWeight() buscan por
+ * bisección en lugar de recorrer el renglón, y se pueden usar
+ * CSR_CommonNeighbors(), CSR_OneStop() y Triangles_Count(). No se usa ningún
+ * ordenamiento por comparación: cada adyacencia se vuelve a llenar recorriendo
+ * la otra en orden de índice, en O(len + edges).
+ *
+ * @param csr La copia. No puede venir de Snapshot_Load() (es de sólo lectura);
+ *            una copia guardada ya ordenada se carga ordenada.
+ *
+ * @return false si no hubo memoria (la copia queda como estaba).
+ */
+bool CSR_Sort( CSR* csr )
+{
+   assert( !csr->map );
+
+   if( csr->sorted ) return true;
+
+   int n = csr->len;
+   size_t cap = csr->edges > 0 ? csr->edges : 1;
+   int* targets = (int*) malloc( cap * sizeof( int ) );
+   float* weights = (float*) malloc( cap * sizeof( float ) );
+   int* sources = (int*) malloc( cap * sizeof( int ) );
+   float* rev_weights = (float*) malloc( cap * sizeof( float ) );
+   int* fill = (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+
+   if( !targets || !weights || !sources || !rev_weights || !fill )
+   {
+      free( targets );
+      free( weights );
+      free( sources );
+      free( rev_weights );
+      free( fill );
+      return false;
+   }
+
+   // las aristas que llegan a v, con v en orden creciente, quedan ordenadas en
+   // el renglón de su vértice de salida
+   memcpy( fill, csr->offsets, n * sizeof( int ) );
+   for( int v = 0; v < n; ++v )
+   {
+      for( int k = csr->rev_offsets[ v ]; k < csr->rev_offsets[ v + 1 ]; ++k )
+      {
+         int u = csr->rev_sources[ k ];
+         targets[ fill[ u ] ] = v;
+         weights[ fill[ u ] ] = csr->rev_weights[ k ];
+         ++fill[ u ];
+      }
+   }
+
+   // y al revés para la adyacencia inversa
+   memcpy( fill, csr->rev_offsets, n * sizeof( int ) );
+   for( int u = 0; u < n; ++u )
+   {
+      for( int k = csr->offsets[ u ]; k < csr->offsets[ u + 1 ]; ++k )
+      {
+         int v = csr->targets[ k ];
+         sources[ fill[ v ] ] = u;
+         rev_weights[ fill[ v ] ] = csr->weights[ k ];
+         ++fill[ v ];
+      }
+   }
+
+   free( csr->targets );
+   free( csr->weights );
+   free( csr->rev_sources );
+   free( csr->rev_weights );
+   free( fill );
+
+   csr->targets = targets;
+   csr->weights = weights;
+   csr->rev_sources = sources;
+   csr->rev_weights = rev_weights;
+   csr->sorted = true;
+   return true;
+}
+
+/**
+ * @brief Indica si existe la arista u -> v.
+ *
+ * Con los renglones ordenados (ver CSR_Sort()) la búsqueda es por bisección y
+ * los últimos LINEAR_MAX elementos se comparan con instrucciones vectoriales;
+ * si no, recorre el renglón de u.
+ *
+ * @param csr La copia.
+ * @param u   Índice del vértice de salida.
+ * @param v   Índice del vértice de llegada.
+ *
+ * @return true si la arista existe.
+ */
+bool CSR_HasEdge( const CSR* csr, int u, int v )
+{
+   return find_in_row( CSR_Neighbors( csr, u ), CSR_Degree( csr, u ), v, csr->sorted ) != -1;
+}
+
+/**
+ * @brief Intersección de dos arreglos ordenados de índices distintos.
+ *
+ * Si los tamaños son parecidos los arreglos se mezclan por bloques con
+ * instrucciones vectoriales (AVX2 o SSE2, según la compilación); si uno es más
+ * de GALLOP_RATIO veces más largo que el otro, cada elemento del corto se busca
+ * en el largo con búsqueda exponencial, que es lo que ocurre con los hubs.
+ *
+ * @param a   Un arreglo en orden creciente, sin repetidos.
+ * @param na  Número de elementos de |a|.
+ * @param b   Otro arreglo en orden creciente, sin repetidos.
+ * @param nb  Número de elementos de |b|.
+ * @param out Recibe los elementos comunes en orden creciente (a lo más
+ *            min( na, nb )); NULL si sólo se quieren contar.
+ *
+ * @return El número de elementos comunes.
+ */
+int CSR_Intersect( const int a[], int na, const int b[], int nb, int out[] )
+{
+   if( na > nb )
+   {
+      const int* t = a; a = b; b = t;
+      int nt = na; na = nb; nb = nt;
+   }
+
+   if( na == 0 ) return 0;
+
+   if( nb / GALLOP_RATIO > na ) return intersect_gallop( a, na, b, nb, out );
+   return intersect_merge( a, na, b, nb, out );
+}
+
+/**
+ * @brief Los aeropuertos a los que se llega en un vuelo directo tanto desde u
+ * como desde v.
+ *
+ * @param csr La copia, con los renglones ordenados (ver CSR_Sort()).
+ * @param u   Índice de un vértice.
+ * @param v   Índice de otro vértice.
+ * @param out Recibe los índices en orden creciente (a lo más el menor de los
+ *            dos grados de salida); NULL si sólo se quieren contar.
+ *
+ * @return El número de vecinos comunes.
+ */
+int CSR_CommonNeighbors( const CSR* csr, int u, int v, int out[] )
+{
+   assert( csr->sorted );
+
+   return CSR_Intersect( CSR_Neighbors( csr, u ), CSR_Degree( csr, u ), CSR_Neighbors( csr, v ), CSR_Degree( csr, v ), out );
+}
+
+/**
+ * @brief Las conexiones con una escala de src a dst: los aeropuertos x con
+ * rutas src -> x y x -> dst.
+ *
+ * @param csr La copia, con los renglones ordenados (ver CSR_Sort()).
+ * @param src Índice del vértice de salida.
+ * @param dst Índice del vértice de llegada.
+ * @param out Recibe los índices de las escalas en orden creciente; NULL si sólo
+ *            se quieren contar.
+ *
+ * @return El número de conexiones con una escala.
+ */
+int CSR_OneStop( const CSR* csr, int src, int dst, int out[] )
+{
+   assert( csr->sorted );
+
+   return CSR_Intersect( CSR_Neighbors( csr, src ), CSR_Degree( csr, src ), CSR_InNeighbors( csr, dst ), CSR_InDegree( csr, dst ), out );
+}
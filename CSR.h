@@ -0,0 +1,134 @@
+#ifndef  CSR_INC
+#define  CSR_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "Graph.h"
+
+/**
+ * @brief Copia de la adyacencia de un grafo en formato CSR (compressed sparse
+ * row). Los vértices y las aristas no cambian; sólo los pesos se pueden
+ * modificar, con CSR_SetEdgeWeight().
+ *
+ * Los vecinos del vértice v están en targets[ offsets[ v ] ] ...
+ * targets[ offsets[ v + 1 ] - 1 ], y el peso de cada arista en la misma posición
+ * de weights[]. Recorrer la adyacencia es un recorrido lineal en memoria. Los
+ * índices de vértice son los mismos que en el grafo original. Cada renglón
+ * conserva el orden de la lista de vecinos, hasta que CSR_Sort() lo ordena por
+ * índice.
+ *
+ * También guarda la adyacencia inversa (las aristas que llegan a cada vértice),
+ * que usan las búsquedas hacia atrás, la ubicación de cada aeropuerto y una
+ * copia de la información de los vértices con su índice por código IATA, de
+ * manera que las consultas no necesitan al grafo original.
+ *
+ * Los arreglos pueden vivir en memoria dinámica (Graph_Freeze()) o en un archivo
+ * proyectado en memoria (Snapshot_Load()); en ambos casos se liberan con CSR_Delete().
+ */
+typedef struct
+{
+   int len;        ///< Número de vértices
+   int edges;      ///< Número de aristas (las de un grafo no dirigido cuentan dos veces)
+   int* offsets;   ///< len + 1 entradas
+   int* targets;   ///< edges entradas: índice del vecino
+   float* weights; ///< edges entradas: peso de la arista
+
+   int* rev_offsets;   ///< len + 1 entradas
+   int* rev_sources;   ///< edges entradas: índice del vértice de salida
+   float* rev_weights; ///< edges entradas: peso de la arista
+
+   float* latitude;  ///< len entradas, en grados; NAN si no se conoce
+   float* longitude; ///< len entradas, en grados; NAN si no se conoce
+
+   Data* data;       ///< len entradas: la información de cada vértice
+   int* iata_index;  ///< IATA_INDEX_SIZE entradas: índice del vértice por código; -1 si no existe
+
+   void* map;        ///< si no es NULL, los arreglos viven en este archivo proyectado
+   size_t map_size;
+
+   unsigned version; ///< la del grafo al congelarlo; aumenta con cada CSR_SetEdgeWeight()
+   bool sorted;      ///< cada renglón (también los de la adyacencia inversa) está en orden creciente de índice; ver CSR_Sort()
+} CSR;
+
+CSR* Graph_Freeze( const Graph* g );
+void CSR_Delete( CSR** p_csr );
+float CSR_SetEdgeWeight( CSR* csr, int u, int v, float weight );
+
+bool CSR_Sort( CSR* csr );
+bool CSR_HasEdge( const CSR* csr, int u, int v );
+int CSR_Intersect( const int a[], int na, const int b[], int nb, int out[] );
+int CSR_CommonNeighbors( const CSR* csr, int u, int v, int out[] );
+int CSR_OneStop( const CSR* csr, int src, int dst, int out[] );
+
+/**
+ * @brief Devuelve el número de vecinos del vértice v.
+ */
+static inline int CSR_Degree( const CSR* csr, int v )
+{
+   assert( 0 <= v && v < csr->len );
+
+   return csr->offsets[ v + 1 ] - csr->offsets[ v ];
+}
+
+/**
+ * @brief Devuelve el arreglo de índices de los vecinos del vértice v (CSR_Degree() entradas).
+ */
+static inline const int* CSR_Neighbors( const CSR* csr, int v )
+{
+   assert( 0 <= v && v < csr->len );
+
+   return csr->targets + csr->offsets[ v ];
+}
+
+/**
+ * @brief Devuelve el arreglo de pesos de las aristas del vértice v (CSR_Degree() entradas).
+ */
+static inline const float* CSR_Weights( const CSR* csr, int v )
+{
+   assert( 0 <= v && v < csr->len );
+
+   return csr->weights + csr->offsets[ v ];
+}
+
+/**
+ * @brief Devuelve el número de aristas que llegan al vértice v.
+ */
+static inline int CSR_InDegree( const CSR* csr, int v )
+{
+   assert( 0 <= v && v < csr->len );
+
+   return csr->rev_offsets[ v + 1 ] - csr->rev_offsets[ v ];
+}
+
+/**
+ * @brief Devuelve el arreglo de índices de los vértices con aristas hacia v (CSR_InDegree() entradas).
+ */
+static inline const int* CSR_InNeighbors( const CSR* csr, int v )
+{
+   assert( 0 <= v && v < csr->len );
+
+   return csr->rev_sources + csr->rev_offsets[ v ];
+}
+
+/**
+ * @brief Devuelve el arreglo de pesos de las aristas que llegan a v (CSR_InDegree() entradas).
+ */
+static inline const float* CSR_InWeights( const CSR* csr, int v )
+{
+   assert( 0 <= v && v < csr->len );
+
+   return csr->rev_weights + csr->rev_offsets[ v ];
+}
+
+/**
+ * @brief Devuelve el índice del vértice con el código IATA indicado; -1 si no existe.
+ */
+static inline int CSR_GetIndexByIata( const CSR* csr, const char iata[] )
+{
+   int key = Graph_IataKey( iata );
+   return key != -1 ? csr->iata_index[ key ] : -1;
+}
+
+#endif   /* ----- #ifndef CSR_INC  ----- */
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Cache.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// cubeta de la llave (Fibonacci hashing sobre la combinación de los tres campos)
+static int bucket_of( const Cache* cache, int kind, int src, int dst )
+{
+   uint32_t h = (uint32_t) kind;
+   h = h * 31u + (uint32_t) src;
+   h = h * 2654435769u + (uint32_t) dst;
+   return (int)( ( h * 2654435769u ) >> ( 32 - cache->bucket_bits ) );
+}
+
+static int find( const Cache* cache, int kind, int src, int dst )
+{
+   int i = cache->buckets[ bucket_of( cache, kind, src, dst ) ];
+   while( i != -1 )
+   {
+      const CacheEntry* e = &cache->entries[ i ];
+      if( e->kind == kind && e->src == src && e->dst == dst ) return i;
+      i = e->next;
+   }
+   return -1;
+}
+
+// saca a la entrada |i| de su cubeta
+static void unlink_entry( Cache* cache, int i )
+{
+   CacheEntry* e = &cache->entries[ i ];
+   int* link = &cache->buckets[ bucket_of( cache, e->kind, e->src, e->dst ) ];
+
+   while( *link != i ) link = &cache->entries[ *link ].next;
+   *link = e->next;
+}
+
+// elige la entrada que se va a reemplazar con el algoritmo del reloj: las
+// libres y las de otra versión se toman de inmediato; a las que se usaron desde
+// la última vuelta se les da otra oportunidad
+static int clock_victim( Cache* cache, unsigned version )
+{
+   for( ;; )
+   {
+      int i = cache->hand;
+      cache->hand = ( cache->hand + 1 ) % cache->capacity;
+
+      CacheEntry* e = &cache->entries[ i ];
+      if( e->kind == 0 || e->version != version ) return i;
+
+      if( !e->referenced )
+      {
+         ++cache->stats.evictions;
+         return i;
+      }
+      e->referenced = false;
+   }
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Crea un caché con lugar para |capacity| resultados.
+ *
+ * @return El caché; NULL si no hubo memoria.
+ */
+Cache* Cache_New( int capacity )
+{
+   assert( capacity > 0 );
+
+   Cache* cache = (Cache*) calloc( 1, sizeof( Cache ) );
+   if( !cache ) return NULL;
+
+   cache->capacity = capacity;
+   cache->bucket_bits = 1;
+   while( ( 1 << cache->bucket_bits ) < capacity ) ++cache->bucket_bits;
+
+   cache->entries = (CacheEntry*) calloc( capacity, sizeof( CacheEntry ) );
+   cache->buckets = (int*) malloc( ( 1 << cache->bucket_bits ) * sizeof( int ) );
+   if( !cache->entries || !cache->buckets )
+   {
+      free( cache->entries );
+      free( cache->buckets );
+      free( cache );
+      return NULL;
+   }
+
+   for( int i = 0; i < ( 1 << cache->bucket_bits ); ++i ) cache->buckets[ i ] = -1;
+
+   cache->stats.bytes = sizeof( Cache ) + capacity * sizeof( CacheEntry ) + ( 1 << cache->bucket_bits ) * sizeof( int );
+   return cache;
+}
+
+void Cache_Delete( Cache** p_cache )
+{
+   assert( *p_cache );
+
+   Cache* cache = *p_cache;
+   for( int i = 0; i < cache->capacity; ++i ) free( cache->entries[ i ].value );
+
+   free( cache->entries );
+   free( cache->buckets );
+   free( cache );
+   *p_cache = NULL;
+}
+
+/**
+ * @brief Busca un resultado.
+ *
+ * @param cache   El caché.
+ * @param kind    El tipo de consulta (distinto de 0).
+ * @param src     El origen.
+ * @param dst     El destino (p.ej. -1 para consultas que no lo usan).
+ * @param version La versión actual del grafo.
+ * @param len     Recibe el tamaño del resultado.
+ *
+ * @return El resultado, válido hasta la siguiente llamada a Cache_Put(); NULL
+ * si no está o si se calculó con otra versión del grafo.
+ */
+const char* Cache_Get( Cache* cache, int kind, int src, int dst, unsigned version, size_t* len )
+{
+   assert( kind != 0 );
+
+   int i = find( cache, kind, src, dst );
+   if( i == -1 )
+   {
+      ++cache->stats.misses;
+      return NULL;
+   }
+
+   CacheEntry* e = &cache->entries[ i ];
+   if( e->version != version )
+   {
+      ++cache->stats.stale;
+      ++cache->stats.misses;
+      return NULL;
+   }
+
+   ++cache->stats.hits;
+   e->referenced = true;
+   *len = e->len;
+   return e->value;
+}
+
+/**
+ * @brief Guarda un resultado (se copia). Si la llave ya estaba, se reemplaza.
+ *
+ * @return false si no hubo memoria para copiar el resultado (el caché no lo guarda).
+ */
+bool Cache_Put( Cache* cache, int kind, int src, int dst, unsigned version, const char* value, size_t len )
+{
+   assert( kind != 0 );
+
+   int i = find( cache, kind, src, dst );
+   if( i == -1 )
+   {
+      i = clock_victim( cache, version );
+
+      CacheEntry* e = &cache->entries[ i ];
+      if( e->kind != 0 )
+      {
+         unlink_entry( cache, i );
+         --cache->stats.entries;
+      }
+
+      e->kind = kind;
+      e->src = src;
+      e->dst = dst;
+      e->len = 0;
+
+      int b = bucket_of( cache, kind, src, dst );
+      e->next = cache->buckets[ b ];
+      cache->buckets[ b ] = i;
+      ++cache->stats.entries;
+   }
+
+   CacheEntry* e = &cache->entries[ i ];
+   if( e->cap < len )
+   {
+      char* p = (char*) realloc( e->value, len );
+      if( !p )
+      {
+         // la entrada queda marcada con una versión que nunca se busca
+         e->version = version - 1;
+         return false;
+      }
+      cache->stats.bytes += len - e->cap;
+      e->value = p;
+      e->cap = len;
+   }
+
+   memcpy( e->value, value, len );
+   e->len = len;
+   e->version = version;
+   e->referenced = false;
+
+   return true;
+}
@@ -0,0 +1,71 @@
+#ifndef  CACHE_INC
+#define  CACHE_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * @brief Una entrada del caché.
+ */
+typedef struct
+{
+   int kind;         ///< tipo de consulta (p.ej. 'N', 'R', 'P'); 0 si la entrada está libre
+   int src;
+   int dst;
+   unsigned version; ///< versión del grafo con la que se calculó el resultado
+   bool referenced;  ///< bit del algoritmo del reloj: se usó desde la última vuelta
+   int next;         ///< siguiente entrada en la misma cubeta; -1 si no hay
+
+   char* value;      ///< el resultado (no necesariamente una cadena)
+   size_t len;       ///< bytes de |value|
+   size_t cap;       ///< bytes reservados para |value|
+} CacheEntry;
+
+/**
+ * @brief Contadores para dimensionar el caché.
+ */
+typedef struct
+{
+   long hits;      ///< consultas contestadas desde el caché
+   long misses;    ///< consultas que no estaban (incluye a las inválidas)
+   long stale;     ///< consultas que estaban, pero calculadas con otra versión del grafo
+   long evictions; ///< entradas válidas desalojadas para hacer lugar
+   int entries;    ///< entradas ocupadas
+   size_t bytes;   ///< memoria total del caché (tabla más resultados)
+} CacheStats;
+
+/**
+ * @brief Caché acotado de resultados de consultas, con llave (tipo, origen,
+ * destino) y reemplazo por el algoritmo del reloj (CLOCK, una aproximación de LRU).
+ *
+ * Cada resultado guarda la versión del grafo con la que se calculó
+ * (Graph::version o CSR::version); una búsqueda con otra versión falla, así que
+ * cualquier modificación del grafo invalida al caché completo sin recorrerlo.
+ *
+ * No usa candados: cada hilo debe tener el suyo.
+ */
+typedef struct
+{
+   CacheEntry* entries; ///< |capacity| entradas
+   int capacity;
+   int* buckets;        ///< primera entrada de cada cubeta; -1 si está vacía
+   int bucket_bits;     ///< hay 2^bucket_bits cubetas
+   int hand;            ///< manecilla del reloj
+   CacheStats stats;
+} Cache;
+
+Cache* Cache_New( int capacity );
+void Cache_Delete( Cache** p_cache );
+
+const char* Cache_Get( Cache* cache, int kind, int src, int dst, unsigned version, size_t* len );
+bool Cache_Put( Cache* cache, int kind, int src, int dst, unsigned version, const char* value, size_t len );
+
+/**
+ * @brief Devuelve los contadores del caché.
+ */
+static inline CacheStats Cache_GetStats( const Cache* cache )
+{
+   return cache->stats;
+}
+
+#endif   /* ----- #ifndef CACHE_INC  ----- */
@@ -0,0 +1,1371 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Graph.h"
+#include "Report.h"
+
+// 29/03/23:
+// Esta versión no modifica los datos originales
+//
+// 2024: los vértices y las aristas se pueden borrar. Un vértice borrado deja una
+// lápida (tombstone) para que los índices de los demás no cambien; Graph_Compact()
+// recupera los lugares y renumera.
+
+#ifndef DBG_HELP
+#define DBG_HELP 0
+#endif  
+
+#if DBG_HELP > 0
+#define DBG_PRINT( ... ) do{ fprintf( stderr, "DBG:" __VA_ARGS__ ); } while( 0 )
+#else
+#define DBG_PRINT( ... ) ;
+#endif  
+
+// los textos (país, ciudad, nombre) se truncan al tamaño de los campos de |Data|
+#define STR_MAX ( sizeof( ( (Data*) 0 )->name ) - 1 )
+
+
+//----------------------------------------------------------------------
+//                           Vertex stuff: 
+//----------------------------------------------------------------------
+
+
+/**
+ * @brief Devuelve un iterador al inicio de la lista de vecinos del vértice.
+ *
+ * El recorrido con iteradores no modifica al vértice ni a su lista, así que es
+ * reentrante y seguro entre hilos mientras nadie modifique el grafo. Es la forma
+ * preferida de recorrer a los vecinos.
+ *
+ * @param v El vértice de trabajo.
+ *
+ * Ejemplo
+ * @code
+   for( List_Iterator it = Vertex_Begin( v ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+   {
+      Edge e = List_Iterator_get( it );
+      // e.index es el índice del vecino y e.weight el peso de la arista
+   }
+   @endcode
+ */
+List_Iterator Vertex_Begin( const Vertex* v )
+{
+   assert( v );
+
+   return List_Begin( v->neighbors );
+}
+
+/**
+ * @brief Hace que cursor libre apunte al inicio de la lista de vecinos. Se debe
+ * de llamar siempre que se vaya a iniciar un recorrido de dicha lista.
+ *
+ * @note El cursor es compartido: dos recorridos simultáneos sobre el mismo vértice
+ * se estorban. Para recorridos anidados o concurrentes use Vertex_Begin().
+ *
+ * @param v El vértice de trabajo (es decir, el vértice del cual queremos obtener 
+ * la lista de vecinos).
+ */
+void Vertex_Start( Vertex* v )
+{
+   assert( v );
+
+   List_Cursor_front( v->neighbors );
+}
+
+/**
+ * @brief Mueve al cursor libre un nodo adelante.
+ *
+ * @param v El vértice de trabajo.
+ *
+ * @pre El cursor apunta a un nodo válido.
+ * @post El cursor se movió un elemento a la derecha en la lista de vecinos.
+ */
+void Vertex_Next( Vertex* v )
+{
+   List_Cursor_next( v->neighbors );
+}
+
+/**
+ * @brief Indica si se alcanzó el final de la lista de vecinos.
+ *
+ * @param v El vértice de trabajo.
+ *
+ * @return true si se alcanazó el final de la lista; false en cualquier otro
+ * caso.
+ */
+bool Vertex_End( const Vertex* v )
+{
+   return List_Cursor_end( v->neighbors );
+}
+
+
+/**
+ * @brief Devuelve el índice del vecino al que apunta actualmente el cursor en la lista de vecinos
+ * del vértice |v|.
+ *
+ * @param v El vértice de trabajo (del cual queremos conocer el índice de su vecino).
+ *
+ * @return El índice del vecino en la lista de vértices.
+ *
+ * @pre El cursor debe apuntar a un nodo válido en la lista de vecinos.
+ *
+ * Ejemplo
+ * @code
+   Vertex* v = Graph_GetVertexByKey( grafo, 100 );
+   for( Vertex_Start( v ); !Vertex_End( v ); Vertex_Next( v ) )
+   {
+      int index = Vertex_GetNeighborIndex( v );
+
+      Item val = Graph_GetDataByIndex( g, index );
+
+      // ...
+   }
+   @endcode
+   @note Esta función debe utilizarse únicamente cuando se recorra el grafo con las funciones 
+   Vertex_Start(), Vertex_End() y Vertex_Next().
+ */
+int Vertex_GetNeighborIndex( const Vertex* v )
+{
+   return List_Cursor_get( v->neighbors ).index;
+}
+
+/**
+ * @brief Devuelve el peso de la arista hacia el vecino al que apunta actualmente el cursor.
+ *
+ * @param v El vértice de trabajo.
+ *
+ * @return El peso (tiempo de vuelo) de la arista.
+ *
+ * @pre El cursor debe apuntar a un nodo válido en la lista de vecinos.
+ */
+float Vertex_GetNeighborWeight( const Vertex* v )
+{
+   return List_Cursor_get( v->neighbors ).weight;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// key: el id a dispersar
+// bits: la tabla tiene 2^bits entradas (1 <= bits <= 31)
+// ret: la posición inicial de búsqueda en la tabla (Fibonacci hashing)
+static int hash_id( int key, int bits )
+{
+   return (int)( ( (uint32_t) key * 2654435769u ) >> ( 32 - bits ) );
+}
+
+// registra en el índice al vértice |index| con llave |key|. Si la llave ya existe
+// no se modifica, de manera que gana el primer vértice insertado (igual que en
+// la búsqueda lineal).
+static void index_insert( Graph* g, int key, int index )
+{
+   int mask = ( 1 << g->id_bits ) - 1;
+   int i = hash_id( key, g->id_bits );
+   while( g->id_index[ i ].index != -1 )
+   {
+      if( g->id_index[ i ].key == key ) return;
+      i = ( i + 1 ) & mask;
+   }
+
+   g->id_index[ i ].key = key;
+   g->id_index[ i ].index = index;
+}
+
+// g: el grafo
+// key: valor a buscar
+// ret: el índice del vértice con esa llave; -1 si no se encontró
+static int find( const Graph* g, int key )
+{
+   int mask = ( 1 << g->id_bits ) - 1;
+   int i = hash_id( key, g->id_bits );
+   while( g->id_index[ i ].index != -1 )
+   {
+      if( g->id_index[ i ].key == key ) return g->id_index[ i ].index;
+      i = ( i + 1 ) & mask;
+   }
+
+   return -1;
+}
+
+// true si |k| está en el intervalo circular (i, j]
+static bool in_range( int i, int k, int j )
+{
+   return i <= j ? ( i < k && k <= j ) : ( i < k || k <= j );
+}
+
+// quita del índice la llave |key| (sólo si apunta al vértice |index|). Las
+// entradas siguientes se recorren hacia atrás (backward shift) para que el
+// sondeo lineal siga encontrándolas sin dejar marcas de borrado
+static void index_remove( Graph* g, int key, int index )
+{
+   int mask = ( 1 << g->id_bits ) - 1;
+   int i = hash_id( key, g->id_bits );
+   while( g->id_index[ i ].index != -1 )
+   {
+      if( g->id_index[ i ].key == key ) break;
+      i = ( i + 1 ) & mask;
+   }
+   if( g->id_index[ i ].index != index ) return;
+
+   for( int j = ( i + 1 ) & mask; g->id_index[ j ].index != -1; j = ( j + 1 ) & mask )
+   {
+      int k = hash_id( g->id_index[ j ].key, g->id_bits );
+      if( in_range( i, k, j ) ) continue;
+
+      g->id_index[ i ] = g->id_index[ j ];
+      i = j;
+   }
+   g->id_index[ i ].index = -1;
+}
+
+// duplica la capacidad del índice de ids y vuelve a insertar todas las llaves
+// ret: false si no hubo memoria (el índice anterior queda intacto)
+static bool grow_index( Graph* g )
+{
+   int bits = g->id_bits + 1;
+   IndexSlot* table = (IndexSlot*) malloc( ( 1 << bits ) * sizeof( IndexSlot ) );
+   if( !table ) return false;
+
+   for( int i = 0; i < ( 1 << bits ); ++i ) table[ i ].index = -1;
+
+   IndexSlot* old = g->id_index;
+   int old_cap = 1 << g->id_bits;
+
+   g->id_index = table;
+   g->id_bits = bits;
+
+   for( int i = 0; i < old_cap; ++i )
+   {
+      if( old[ i ].index != -1 ) index_insert( g, old[ i ].key, old[ i ].index );
+   }
+
+   free( old );
+   return true;
+}
+
+// cambia la capacidad de todos los arreglos de vértices a |size| entradas
+// ret: false si algún arreglo no cambió por falta de memoria; los que sí
+// cambiaron siguen siendo válidos (no se modifica g->size)
+static bool resize_vertices( Graph* g, int size )
+{
+   bool ok = true;
+
+#define RESIZE( field ) do{ \
+      void* p = realloc( g->field, size * sizeof( *g->field ) ); \
+      if( p ) g->field = p; else ok = false; \
+   } while( 0 )
+
+   RESIZE( vertices );
+   RESIZE( ids );
+   RESIZE( utc_times );
+   RESIZE( iata_codes );
+   RESIZE( latitudes );
+   RESIZE( longitudes );
+   RESIZE( countries );
+   RESIZE( cities );
+   RESIZE( names );
+
+#undef RESIZE
+
+   return ok;
+}
+
+static void free_vertices( Graph* g )
+{
+   free( g->vertices );
+   free( g->ids );
+   free( g->utc_times );
+   free( g->iata_codes );
+   free( g->latitudes );
+   free( g->longitudes );
+   free( g->countries );
+   free( g->cities );
+   free( g->names );
+}
+
+// duplica la capacidad de los arreglos de vértices
+// ret: false si no hubo memoria (los vértices quedan intactos)
+static bool grow_vertices( Graph* g )
+{
+   int size = g->size * 2;
+   if( !resize_vertices( g, size ) ) return false;
+
+   memset( g->vertices + g->size, 0, ( size - g->size ) * sizeof( Vertex ) );
+
+   g->size = size;
+   return true;
+}
+
+// copia a lo más cap-1 caracteres de |src| en |dst| y siempre termina la cadena
+static void copy_str( char dst[], const char src[], size_t cap )
+{
+   size_t len = strlen( src );
+   if( len >= cap ) len = cap - 1;
+
+   memcpy( dst, src, len );
+   dst[ len ] = '\0';
+}
+
+// si |s| vive en el almacén de textos del grafo la copia en |buf| (STR_MAX + 1
+// bytes), porque agregar otra cadena al almacén puede cambiarlo de lugar
+static const char* unpooled( const Graph* g, const char* s, char buf[] )
+{
+   uintptr_t offset = (uintptr_t) s - (uintptr_t) g->strings.chars;
+   if( offset >= g->strings.len ) return s;
+
+   copy_str( buf, s, STR_MAX + 1 );
+   return buf;
+}
+
+// agrega el nodo |n| al conjunto de vecinos (que tiene espacio de sobra)
+static void set_insert( Node** set, int bits, Node* n )
+{
+   int mask = ( 1 << bits ) - 1;
+   int i = hash_id( n->data.index, bits );
+   while( set[ i ] )
+   {
+      if( set[ i ]->data.index == n->data.index ) return;
+      i = ( i + 1 ) & mask;
+   }
+   set[ i ] = n;
+}
+
+// quita del conjunto de vecinos el nodo |n| (backward shift, como index_remove())
+static void set_remove( Vertex* vertex, const Node* n )
+{
+   Node** set = vertex->neighbor_set;
+   int mask = ( 1 << vertex->set_bits ) - 1;
+   int i = hash_id( n->data.index, vertex->set_bits );
+   while( set[ i ] != n )
+   {
+      assert( set[ i ] );
+      i = ( i + 1 ) & mask;
+   }
+
+   for( int j = ( i + 1 ) & mask; set[ j ]; j = ( j + 1 ) & mask )
+   {
+      int k = hash_id( set[ j ]->data.index, vertex->set_bits );
+      if( in_range( i, k, j ) ) continue;
+
+      set[ i ] = set[ j ];
+      i = j;
+   }
+   set[ i ] = NULL;
+}
+
+// (re)construye el conjunto de vecinos de |vertex| a partir de su lista, con
+// capacidad para al menos 2*|min_cap| entradas
+// ret: false si no hubo memoria (el conjunto anterior, si había, queda intacto)
+static bool set_rebuild( Vertex* vertex, int min_cap )
+{
+   int bits = 1;
+   while( ( 1 << bits ) < 2 * min_cap ) ++bits;
+
+   Node** set = (Node**) calloc( 1 << bits, sizeof( Node* ) );
+   if( !set ) return false;
+
+   for( Node* n = vertex->neighbors->first; n; n = n->next ) set_insert( set, bits, n );
+
+   free( vertex->neighbor_set );
+   vertex->neighbor_set = set;
+   vertex->set_bits = bits;
+   return true;
+}
+
+// busca el índice del vértice vecino en la lista de vecinos. Los vértices de
+// grado alto lo buscan en su conjunto en O(1); los demás recorren la lista (que
+// es corta)
+// ret: el nodo de la lista con esa arista; NULL si no existe
+static Node* find_neighbor( const Vertex* v, int index )
+{
+   if( v->neighbor_set )
+   {
+      int mask = ( 1 << v->set_bits ) - 1;
+      int i = hash_id( index, v->set_bits );
+      while( v->neighbor_set[ i ] )
+      {
+         if( v->neighbor_set[ i ]->data.index == index ) return v->neighbor_set[ i ];
+         i = ( i + 1 ) & mask;
+      }
+      return NULL;
+   }
+
+   if( !v->neighbors ) return NULL;
+
+   for( Node* n = v->neighbors->first; n; n = n->next )
+   {
+      if( n->data.index == index ) return n;
+   }
+   return NULL;
+}
+
+// agrega la arista al final de la lista de vecinos y mantiene el conjunto
+// pre: la arista no existe
+static void push_neighbor( Vertex* vertex, int index, float weight )
+{
+   List_Push_back( vertex->neighbors, index, weight );
+   ++vertex->degree;
+
+   if( vertex->neighbor_set && 2 * vertex->degree <= ( 1 << vertex->set_bits ) )
+   {
+      set_insert( vertex->neighbor_set, vertex->set_bits, vertex->neighbors->last );
+   }
+   else if( vertex->degree >= VERTEX_SET_MIN_DEGREE )
+   {
+      // se crea (o se duplica) el conjunto; si no hay memoria se sigue usando la
+      // lista y se vuelve a intentar en la siguiente inserción
+      if( !set_rebuild( vertex, vertex->degree ) )
+      {
+         free( vertex->neighbor_set );
+         vertex->neighbor_set = NULL;
+      }
+   }
+}
+
+// quita la arista hacia |index| de la lista de vecinos en O(1) (más la búsqueda,
+// que también es O(1) en los vértices de grado alto)
+// ret: true si la arista existía
+static bool remove_neighbor( Vertex* vertex, int index )
+{
+   Node* n = find_neighbor( vertex, index );
+   if( !n ) return false;
+
+   if( vertex->neighbor_set ) set_remove( vertex, n );
+   List_Erase( vertex->neighbors, n );
+   --vertex->degree;
+
+   return true;
+}
+
+// vertex: vértice de trabajo
+// index: índice en la lista de vértices del vértice vecino que está por insertarse
+// ret: true si la arista se insertó; false si ya existía
+static bool insert( Vertex* vertex, int index, float weight )
+{
+   // crear la lista si no existe!
+   
+   if( !vertex->neighbors )
+   {
+      vertex->neighbors = List_New();
+   }
+
+   if( vertex->neighbors && !find_neighbor( vertex, index ) )
+   {
+      push_neighbor( vertex, index, weight );
+
+      DBG_PRINT( "insert():Inserting the neighbor with idx:%d\n", index );
+      return true;
+   } 
+
+   DBG_PRINT( "insert: duplicated index\n" );
+   return false;
+}
+
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+
+/**
+ * @brief Crea un nuevo grafo.
+ *
+ * @param size Capacidad inicial de la lista de vértices. La lista crece sola
+ * (al doble) cuando se llena, así que basta con una estimación.
+ *
+ * @return Un nuevo grafo.
+ *
+ * @pre El número de elementos es mayor que 0.
+ */
+Graph* Graph_New( int size, eGraphType type )
+{
+   assert( size > 0 );
+
+   Graph* g = (Graph*) calloc( 1, sizeof( Graph ) );
+   if( g )
+   {
+      g->size = size;
+      g->len = 0;
+      g->removed = 0;
+      g->type = type;
+      g->version = 0;
+
+      bool ok = resize_vertices( g, size );
+      ok = StrPool_Init( &g->strings ) && ok;
+
+      // el índice se mantiene a lo más a la mitad de su capacidad
+      g->id_bits = 1;
+      while( ( 1 << g->id_bits ) < 2 * size ) ++g->id_bits;
+
+      g->id_index = (IndexSlot*) malloc( ( 1 << g->id_bits ) * sizeof( IndexSlot ) );
+
+      g->iata_index = (int*) malloc( IATA_INDEX_SIZE * sizeof( int ) );
+
+      if( !ok || !g->id_index || !g->iata_index )
+      {
+         free_vertices( g );
+         StrPool_Free( &g->strings );
+         free( g->id_index );
+         free( g->iata_index );
+         free( g );
+         g = NULL;
+      }
+      else
+      {
+         memset( g->vertices, 0, size * sizeof( Vertex ) );
+         for( int i = 0; i < ( 1 << g->id_bits ); ++i ) g->id_index[ i ].index = -1;
+         for( int i = 0; i < IATA_INDEX_SIZE; ++i ) g->iata_index[ i ] = -1;
+      }
+   }
+
+   return g;
+   // el cliente es responsable de verificar que el grafo se haya creado correctamente
+}
+
+void Graph_Delete( Graph** g )
+{
+   assert( *g );
+
+   Graph* graph = *g;
+   // para simplificar la notación 
+
+   for( int i = 0; i < graph->size; ++i )
+   {
+      Vertex* vertex = &graph->vertices[ i ];
+      // para simplificar la notación. 
+      // La variable |vertex| sólo existe dentro de este for.
+
+      if( vertex->neighbors )
+      {
+         List_Delete( &(vertex->neighbors) );
+      }
+      free( vertex->neighbor_set );
+   }
+
+   free( graph->iata_index );
+   free( graph->id_index );
+   free_vertices( graph );
+   StrPool_Free( &graph->strings );
+   free( graph );
+   *g = NULL;
+}
+
+/**
+ * @brief Imprime un reporte del grafo
+ *
+ * El reporte se arma con Report_Write() en formato de texto; para CSV o JSON, o
+ * para usar varios hilos, llame a Report_Write() directamente.
+ *
+ * @param g     El grafo.
+ * @param depth Cuán detallado deberá ser el reporte (0: lo mínimo)
+ */
+void Graph_Print( const Graph* g, int depth )
+{
+   (void) depth;
+
+   Report_Write( g, eReportFormat_TEXT, stdout, 1 );
+}
+
+
+/**
+ * @brief Inserta un nuevo vértice (aeropuerto) en el grafo.
+ *
+ * Las cadenas se truncan al tamaño de los campos de |Data|. País, ciudad y
+ * nombre se guardan una sola vez en el almacén de textos del grafo, por más
+ * aeropuertos que los compartan. Si el código IATA consiste en 3 letras
+ * mayúsculas, el vértice también se registra en el índice por código IATA
+ * (gana el primero que lo use).
+ *
+ * Si los arreglos de vértices están llenos se duplica su capacidad, así que la
+ * inserción es O(1) amortizado.
+ *
+ * @warning Como los arreglos de vértices pueden cambiar de lugar en memoria,
+ * esta función invalida todas las referencias |Vertex*| obtenidas antes (p.ej.
+ * con Graph_GetVertexByIndex() o Graph_GetVertexByIata()), así como los textos
+ * devueltos por Graph_GetCountry() y compañía (éstos sí se pueden pasar como
+ * argumentos de la misma llamada). Los índices de los
+ * vértices no cambian, y los iteradores sobre listas de vecinos siguen siendo
+ * válidos. Las copias CSR no se ven afectadas.
+ *
+ * @return false si no hubo memoria para crecer; el grafo queda sin cambios.
+ */
+bool Graph_AddVertex( Graph* g, int id, const char iata[], const char country[], const char city[], const char name[], int utc )
+{
+   if( g->len == g->size && !grow_vertices( g ) ) return false;
+
+   if( 2 * ( g->len + 1 ) > ( 1 << g->id_bits ) && !grow_index( g ) ) return false;
+   // el índice se mantiene a lo más a la mitad de su capacidad
+
+   // los textos pueden venir de Graph_GetCountry() y compañía
+   char buf[ 3 ][ STR_MAX + 1 ];
+   country = unpooled( g, country, buf[ 0 ] );
+   city = unpooled( g, city, buf[ 1 ] );
+   name = unpooled( g, name, buf[ 2 ] );
+
+   StrRef country_ref = StrPool_Intern( &g->strings, country, STR_MAX );
+   StrRef city_ref = StrPool_Intern( &g->strings, city, STR_MAX );
+   StrRef name_ref = StrPool_Intern( &g->strings, name, STR_MAX );
+   if( country_ref == STRPOOL_ERROR || city_ref == STRPOOL_ERROR || name_ref == STRPOOL_ERROR ) return false;
+   // si alguno falló, los que sí se agregaron sólo ocupan lugar en el almacén
+
+   int v = g->len;
+
+   g->ids[ v ]       = id;
+   g->utc_times[ v ] = utc;
+   g->countries[ v ] = country_ref;
+   g->cities[ v ]    = city_ref;
+   g->names[ v ]     = name_ref;
+
+   copy_str( g->iata_codes[ v ], iata, sizeof( g->iata_codes[ v ] ) );
+
+   g->latitudes[ v ]  = NAN;
+   g->longitudes[ v ] = NAN;
+   // la ubicación es opcional; se asigna con Graph_SetLocation()
+
+   Vertex* vertex = &g->vertices[ v ];
+   // para simplificar la notación 
+
+   vertex->neighbors = NULL;
+   vertex->degree = 0;
+   vertex->neighbor_set = NULL;
+   vertex->set_bits = 0;
+   vertex->removed = false;
+
+   index_insert( g, id, v );
+
+   int key = Graph_IataKey( g->iata_codes[ v ] );
+   if( key != -1 && g->iata_index[ key ] == -1 ) g->iata_index[ key ] = v;
+
+   ++g->len;
+   ++g->version;
+
+   return true;
+}
+
+/**
+ * @brief Asigna la ubicación geográfica de un aeropuerto.
+ *
+ * La ubicación es opcional; la usa la búsqueda A* (Path_AStar()) para acotar
+ * el tiempo de vuelo que falta hacia el destino.
+ *
+ * @param g         El grafo.
+ * @param id        El id del aeropuerto.
+ * @param latitude  Latitud en grados.
+ * @param longitude Longitud en grados.
+ *
+ * @return false si el aeropuerto no existe.
+ */
+bool Graph_SetLocation( Graph* g, int id, float latitude, float longitude )
+{
+   int idx = find( g, id );
+   if( idx == -1 ) return false;
+
+   g->latitudes[ idx ]  = latitude;
+   g->longitudes[ idx ] = longitude;
+   ++g->version;
+
+   return true;
+}
+
+int Graph_GetSize( Graph* g )
+{
+   return g->size;
+}
+
+
+/**
+ * @brief Inserta una relación de adyacencia del vértice |start| hacia el vértice |finish|.
+ *
+ * @param g      El grafo.
+ * @param start  Vértice de salida (el dato)
+ * @param finish Vertice de llegada (el dato)
+ *
+ * @return false si uno o ambos vértices no existen; true si la relación se creó con éxito.
+ *
+ * @pre El grafo no puede estar vacío.
+ */
+bool Graph_AddEdge( Graph* g, int start, int finish  )
+{
+   assert( g->len > 0 );
+
+   // obtenemos los índices correspondientes:
+   int start_idx = find( g, start );
+   int finish_idx = find( g, finish );
+
+   DBG_PRINT( "AddEdge(): from:%d (with index:%d), to:%d (with index:%d)\n", start, start_idx, finish, finish_idx );
+
+   if( start_idx == -1 || finish_idx == -1 ) return false;
+   // uno o ambos vértices no existen
+
+   bool changed = insert( &g->vertices[ start_idx ], finish_idx, 0.0 );
+   // insertamos la arista start-finish
+
+   if( g->type == eGraphType_UNDIRECTED ) changed |= insert( &g->vertices[ finish_idx ], start_idx, 0.0 );
+   // si el grafo no es dirigido, entonces insertamos la arista finish-start
+
+   if( changed ) ++g->version;
+
+   return true;
+}
+bool Graph_AddWeightedEdge( Graph* g, int start, int finish, float peso)
+{
+   assert( g->len > 0 );
+
+   // obtenemos los índices correspondientes:
+   int start_idx = find( g, start );
+   int finish_idx = find( g, finish );
+
+   DBG_PRINT( "AddEdge(): from:%d (with index:%d), to:%d (with index:%d)\n", start, start_idx, finish, finish_idx );
+
+   if( start_idx == -1 || finish_idx == -1 ) return false;
+   // uno o ambos vértices no existen
+
+   bool changed = insert( &g->vertices[ start_idx ], finish_idx, peso );
+   // insertamos la arista start-finish
+
+   if( g->type == eGraphType_UNDIRECTED ) changed |= insert( &g->vertices[ finish_idx ], start_idx, peso );
+   // si el grafo no es dirigido, entonces insertamos la arista finish-start
+
+   if( changed ) ++g->version;
+
+   return true;
+}
+
+/**
+ * @brief Cambia el peso (tiempo de vuelo) de la arista del vértice |start| hacia
+ * el vértice |finish|. En un grafo no dirigido también cambia la arista de regreso.
+ *
+ * La arista se busca como en las inserciones: en O(1) en los vértices de grado
+ * alto (ver VERTEX_SET_MIN_DEGREE), que son los hubs.
+ *
+ * Las copias CSR ya congeladas no se ven afectadas; para ellas use CSR_SetEdgeWeight().
+ *
+ * @param g      El grafo.
+ * @param start  Vértice de salida (el dato)
+ * @param finish Vertice de llegada (el dato)
+ * @param peso   El nuevo peso.
+ *
+ * @return false si uno o ambos vértices, o la arista, no existen.
+ */
+bool Graph_SetEdgeWeight( Graph* g, int start, int finish, float peso )
+{
+   int start_idx = find( g, start );
+   int finish_idx = find( g, finish );
+
+   if( start_idx == -1 || finish_idx == -1 ) return false;
+
+   Node* n = find_neighbor( &g->vertices[ start_idx ], finish_idx );
+   if( !n ) return false;
+
+   n->data.weight = peso;
+
+   if( g->type == eGraphType_UNDIRECTED )
+   {
+      Node* back = find_neighbor( &g->vertices[ finish_idx ], start_idx );
+      if( back ) back->data.weight = peso;
+   }
+
+   ++g->version;
+   return true;
+}
+
+/**
+ * @brief Inserta un lote de aristas dadas por índices de vértice (no por ids).
+ *
+ * Pensada para cargas masivas: no busca ids y no revisa duplicados arista por
+ * arista. El lote se ordena por (origen, destino) con dos pasadas de conteo
+ * (O(n + V)), los duplicados del lote se descartan (gana la primera aparición,
+ * como en Graph_AddWeightedEdge()) y cada lista recibe sus aristas de una vez.
+ * Sólo cuando la lista de un vértice ya tenía vecinos se revisa si la arista
+ * existía.
+ *
+ * @param g       El grafo.
+ * @param src     Índices de los vértices de salida.
+ * @param dst     Índices de los vértices de llegada.
+ * @param weights Pesos de las aristas; NULL para peso 0.
+ * @param n       Número de aristas del lote.
+ *
+ * @return El número de aristas insertadas (en un grafo no dirigido, cada arista
+ * cuenta una vez por sentido); -1 si no hubo memoria.
+ *
+ * @pre Todos los índices son válidos.
+ */
+int Graph_AddEdgesByIndex( Graph* g, const int src[], const int dst[], const float weights[], int n )
+{
+   typedef struct { int src; int dst; float weight; } Pending;
+
+   int m = g->type == eGraphType_UNDIRECTED ? 2 * n : n;
+   Pending* a = (Pending*) malloc( ( m > 0 ? m : 1 ) * sizeof( Pending ) );
+   Pending* b = (Pending*) malloc( ( m > 0 ? m : 1 ) * sizeof( Pending ) );
+   int* count = (int*) malloc( ( g->len + 1 ) * sizeof( int ) );
+
+   if( !a || !b || !count )
+   {
+      free( a );
+      free( b );
+      free( count );
+      return -1;
+   }
+
+   for( int i = 0, k = 0; i < n; ++i )
+   {
+      assert( 0 <= src[ i ] && src[ i ] < g->len && !g->vertices[ src[ i ] ].removed );
+      assert( 0 <= dst[ i ] && dst[ i ] < g->len && !g->vertices[ dst[ i ] ].removed );
+
+      float w = weights ? weights[ i ] : 0.0f;
+
+      a[ k ].src = src[ i ]; a[ k ].dst = dst[ i ]; a[ k ].weight = w; ++k;
+
+      if( g->type == eGraphType_UNDIRECTED )
+      {
+         a[ k ].src = dst[ i ]; a[ k ].dst = src[ i ]; a[ k ].weight = w; ++k;
+      }
+   }
+
+   // primera pasada (estable) por destino: a -> b
+   memset( count, 0, ( g->len + 1 ) * sizeof( int ) );
+   for( int i = 0; i < m; ++i ) ++count[ a[ i ].dst + 1 ];
+   for( int v = 0; v < g->len; ++v ) count[ v + 1 ] += count[ v ];
+   for( int i = 0; i < m; ++i ) b[ count[ a[ i ].dst ]++ ] = a[ i ];
+
+   // segunda pasada (estable) por origen: b -> a. Queda ordenado por (origen, destino)
+   // y, a igualdad de ambos, en el orden original
+   memset( count, 0, ( g->len + 1 ) * sizeof( int ) );
+   for( int i = 0; i < m; ++i ) ++count[ b[ i ].src + 1 ];
+   for( int v = 0; v < g->len; ++v ) count[ v + 1 ] += count[ v ];
+   for( int i = 0; i < m; ++i ) a[ count[ b[ i ].src ]++ ] = b[ i ];
+
+   int inserted = 0;
+   for( int i = 0; i < m; )
+   {
+      Vertex* vertex = &g->vertices[ a[ i ].src ];
+      bool check = vertex->neighbors && !List_Is_empty( vertex->neighbors );
+
+      if( !vertex->neighbors ) vertex->neighbors = List_New();
+      assert( vertex->neighbors );
+
+      int j = i;
+      for( ; j < m && a[ j ].src == a[ i ].src; ++j )
+      {
+         if( j > i && a[ j ].dst == a[ j - 1 ].dst ) continue;
+         // duplicado dentro del lote
+
+         if( check && find_neighbor( vertex, a[ j ].dst ) ) continue;
+         // ya existía en el grafo
+
+         push_neighbor( vertex, a[ j ].dst, a[ j ].weight );
+         ++inserted;
+      }
+      i = j;
+   }
+
+   free( a );
+   free( b );
+   free( count );
+
+   if( inserted > 0 ) ++g->version;
+   return inserted;
+}
+
+/**
+ * @brief Quita la relación de adyacencia del vértice |start| hacia el vértice
+ * |finish|. En un grafo no dirigido también quita la arista de regreso.
+ *
+ * El nodo de la arista regresa a los nodos libres de la lista del vértice, así
+ * que la siguiente inserción lo reutiliza. La búsqueda es O(1) en los vértices
+ * de grado alto (ver VERTEX_SET_MIN_DEGREE) y el borrado siempre es O(1).
+ *
+ * @param g      El grafo.
+ * @param start  Vértice de salida (el dato)
+ * @param finish Vertice de llegada (el dato)
+ *
+ * @return false si uno o ambos vértices, o la arista, no existen.
+ */
+bool Graph_RemoveEdge( Graph* g, int start, int finish )
+{
+   int start_idx = find( g, start );
+   int finish_idx = find( g, finish );
+
+   if( start_idx == -1 || finish_idx == -1 ) return false;
+
+   if( !remove_neighbor( &g->vertices[ start_idx ], finish_idx ) ) return false;
+
+   if( g->type == eGraphType_UNDIRECTED ) remove_neighbor( &g->vertices[ finish_idx ], start_idx );
+
+   ++g->version;
+   return true;
+}
+
+/**
+ * @brief Borra un vértice (aeropuerto) y sus aristas de salida.
+ *
+ * El vértice queda como lápida: su lugar en la lista de vértices no se reutiliza
+ * y los índices de los demás vértices no cambian, así que las copias CSR, las
+ * rutas y los índices que tenga el cliente siguen siendo válidos. El id y el
+ * código IATA quedan libres para un vértice nuevo.
+ *
+ * En un grafo no dirigido también se quitan las aristas de regreso (O(grado)).
+ * En un grafo dirigido no hay lista de entrada, así que las aristas que llegaban
+ * al vértice quedan colgando; los recorridos las saltan con Graph_IsRemoved() y
+ * Graph_Compact() las elimina.
+ *
+ * @param g  El grafo.
+ * @param id El id del aeropuerto.
+ *
+ * @return false si el aeropuerto no existe.
+ */
+bool Graph_RemoveVertex( Graph* g, int id )
+{
+   int idx = find( g, id );
+   if( idx == -1 ) return false;
+
+   Vertex* vertex = &g->vertices[ idx ];
+   // para simplificar la notación 
+
+   if( vertex->neighbors )
+   {
+      if( g->type == eGraphType_UNDIRECTED )
+      {
+         for( Node* n = vertex->neighbors->first; n; n = n->next )
+         {
+            if( n->data.index != idx ) remove_neighbor( &g->vertices[ n->data.index ], idx );
+         }
+      }
+
+      List_Delete( &vertex->neighbors );
+   }
+
+   free( vertex->neighbor_set );
+   vertex->neighbor_set = NULL;
+   vertex->set_bits = 0;
+   vertex->degree = 0;
+   vertex->removed = true;
+
+   index_remove( g, id, idx );
+
+   int key = Graph_IataKey( g->iata_codes[ idx ] );
+   if( key != -1 && g->iata_index[ key ] == idx ) g->iata_index[ key ] = -1;
+
+   ++g->removed;
+   ++g->version;
+
+   return true;
+}
+
+/**
+ * @brief Recupera los lugares de los vértices borrados.
+ *
+ * Los vértices vivos se recorren hacia el inicio de la lista conservando su
+ * orden, las aristas se renumeran (y se descartan las que llegaban a vértices
+ * borrados) y cada lista de vecinos se vuelve a construir en bloques nuevos,
+ * de manera que la memoria que dejaron los borrados regresa al sistema. Los
+ * textos se copian a un almacén nuevo sin los que sólo usaban los borrados.
+ * Si los arreglos de vértices quedaron muy holgados, también se encogen. Es
+ * O(V + E).
+ *
+ * Como cambia los índices, invalida las referencias |Vertex*|, los iteradores,
+ * las copias CSR y cualquier índice guardado por el cliente; |old_to_new| sirve
+ * para traducir estos últimos.
+ *
+ * @param g          El grafo.
+ * @param old_to_new Si no es NULL, arreglo de Graph_GetLen() entradas (tomado
+ *                   antes de la llamada) que recibe el índice nuevo de cada
+ *                   vértice, o -1 si estaba borrado.
+ *
+ * @return El nuevo número de vértices; -1 si no hubo memoria (el grafo queda
+ * sin cambios).
+ */
+int Graph_Compact( Graph* g, int old_to_new[] )
+{
+   int n = g->len;
+
+   int* map = old_to_new ? old_to_new : (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+   List** lists = (List**) calloc( n > 0 ? n : 1, sizeof( List* ) );
+   int* degrees = (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+
+   int len = 0;
+   for( int i = 0; i < n; ++i ) if( map ) map[ i ] = g->vertices[ i ].removed ? -1 : len++;
+
+   // primero se construyen las listas nuevas, para poder abortar sin tocar el grafo
+   bool ok = map && lists && degrees;
+   for( int i = 0; ok && i < n; ++i )
+   {
+      const Vertex* vertex = &g->vertices[ i ];
+      if( vertex->removed || !vertex->neighbors ) continue;
+
+      lists[ i ] = List_New();
+      ok = lists[ i ] != NULL;
+
+      degrees[ i ] = 0;
+      for( const Node* e = vertex->neighbors->first; ok && e; e = e->next )
+      {
+         if( map[ e->data.index ] == -1 ) continue;
+
+         List_Push_back( lists[ i ], map[ e->data.index ], e->data.weight );
+         ++degrees[ i ];
+      }
+   }
+
+   // el índice de ids se dimensiona de acuerdo a la nueva capacidad
+   int size = g->size > 4 * len ? ( len > 8 ? 2 * len : 16 ) : g->size;
+   int bits = 1;
+   while( ( 1 << bits ) < 2 * size ) ++bits;
+
+   IndexSlot* id_index = ok ? (IndexSlot*) malloc( ( 1 << bits ) * sizeof( IndexSlot ) ) : NULL;
+
+   // los textos de los vivos, en un almacén nuevo. Si no hay memoria para él
+   // se conserva el anterior, que sigue siendo válido
+   StrPool strings;
+   StrRef* refs = id_index ? (StrRef*) malloc( ( len > 0 ? 3 * len : 1 ) * sizeof( StrRef ) ) : NULL;
+   bool repack = refs && StrPool_Init( &strings );
+   for( int i = 0; repack && i < n; ++i )
+   {
+      if( map[ i ] == -1 ) continue;
+
+      StrRef* r = &refs[ 3 * map[ i ] ];
+      r[ 0 ] = StrPool_Intern( &strings, Graph_GetCountry( g, i ), STR_MAX );
+      r[ 1 ] = StrPool_Intern( &strings, Graph_GetCity( g, i ), STR_MAX );
+      r[ 2 ] = StrPool_Intern( &strings, Graph_GetName( g, i ), STR_MAX );
+      repack = r[ 0 ] != STRPOOL_ERROR && r[ 1 ] != STRPOOL_ERROR && r[ 2 ] != STRPOOL_ERROR;
+
+      if( !repack ) StrPool_Free( &strings );
+   }
+
+   if( !id_index )
+   {
+      for( int i = 0; lists && i < n; ++i ) if( lists[ i ] ) List_Delete( &lists[ i ] );
+      if( map != old_to_new ) free( map );
+      free( lists );
+      free( degrees );
+      return -1;
+   }
+
+   for( int i = 0; i < n; ++i )
+   {
+      if( map[ i ] == -1 ) continue;
+
+      Vertex* vertex = &g->vertices[ i ];
+      if( vertex->neighbors ) List_Delete( &vertex->neighbors );
+      free( vertex->neighbor_set );
+
+      int k = map[ i ];
+      // k <= i, así que ese lugar ya se desocupó
+      g->ids[ k ]        = g->ids[ i ];
+      g->utc_times[ k ]  = g->utc_times[ i ];
+      g->latitudes[ k ]  = g->latitudes[ i ];
+      g->longitudes[ k ] = g->longitudes[ i ];
+      memcpy( g->iata_codes[ k ], g->iata_codes[ i ], sizeof( g->iata_codes[ k ] ) );
+
+      if( repack )
+      {
+         g->countries[ k ] = refs[ 3 * k ];
+         g->cities[ k ]    = refs[ 3 * k + 1 ];
+         g->names[ k ]     = refs[ 3 * k + 2 ];
+      }
+      else
+      {
+         g->countries[ k ] = g->countries[ i ];
+         g->cities[ k ]    = g->cities[ i ];
+         g->names[ k ]     = g->names[ i ];
+      }
+
+      Vertex* moved = &g->vertices[ k ];
+
+      moved->neighbors = lists[ i ];
+      moved->degree = lists[ i ] ? degrees[ i ] : 0;
+      moved->neighbor_set = NULL;
+      moved->set_bits = 0;
+      moved->removed = false;
+
+      if( moved->degree >= VERTEX_SET_MIN_DEGREE ) set_rebuild( moved, moved->degree );
+      // si no hay memoria para el conjunto se usa la lista
+   }
+   memset( g->vertices + len, 0, ( n - len ) * sizeof( Vertex ) );
+
+   if( repack )
+   {
+      StrPool_Free( &g->strings );
+      g->strings = strings;
+   }
+
+   if( size < g->size )
+   {
+      resize_vertices( g, size );
+      g->size = size;
+      // un arreglo que no se pudo encoger conserva su capacidad anterior, que es mayor
+   }
+
+   free( g->id_index );
+   g->id_index = id_index;
+   g->id_bits = bits;
+   for( int i = 0; i < ( 1 << bits ); ++i ) g->id_index[ i ].index = -1;
+   for( int i = 0; i < IATA_INDEX_SIZE; ++i ) g->iata_index[ i ] = -1;
+
+   for( int i = 0; i < len; ++i )
+   {
+      index_insert( g, g->ids[ i ], i );
+
+      int key = Graph_IataKey( g->iata_codes[ i ] );
+      if( key != -1 && g->iata_index[ key ] == -1 ) g->iata_index[ key ] = i;
+   }
+
+   g->len = len;
+   g->removed = 0;
+   ++g->version;
+
+   if( map != old_to_new ) free( map );
+   free( lists );
+   free( degrees );
+   free( refs );
+   return len;
+}
+
+int Graph_GetLen( Graph* g )
+{
+   return g->len;
+}
+
+
+/**
+ * @brief Devuelve la información asociada al vértice indicado.
+ *
+ * @param g          Un grafo.
+ * @param vertex_idx El índice del vértice del cual queremos conocer su información.
+ *
+ * @return La información asociada al vértice vertex_idx.
+ */
+Item Graph_GetDataByIndex( const Graph* g, int vertex_idx )
+{
+   assert( 0 <= vertex_idx && vertex_idx < g->len );
+
+   return g->ids[ vertex_idx ];
+}
+
+/**
+ * @brief Arma el registro completo del aeropuerto a partir de los arreglos
+ * paralelos del grafo.
+ *
+ * @param g          Un grafo.
+ * @param vertex_idx El índice del vértice.
+ *
+ * @return Una copia de la información del aeropuerto.
+ */
+Data Graph_GetData( const Graph* g, int vertex_idx )
+{
+   assert( 0 <= vertex_idx && vertex_idx < g->len );
+
+   Data data;
+   memset( &data, 0, sizeof( Data ) );
+   // así el registro no lleva basura a los snapshots
+
+   data.id = g->ids[ vertex_idx ];
+   data.utc_time = g->utc_times[ vertex_idx ];
+   memcpy( data.iata_code, g->iata_codes[ vertex_idx ], sizeof( data.iata_code ) );
+   copy_str( data.country, Graph_GetCountry( g, vertex_idx ), sizeof( data.country ) );
+   copy_str( data.city, Graph_GetCity( g, vertex_idx ), sizeof( data.city ) );
+   copy_str( data.name, Graph_GetName( g, vertex_idx ), sizeof( data.name ) );
+   data.latitude = g->latitudes[ vertex_idx ];
+   data.longitude = g->longitudes[ vertex_idx ];
+
+   return data;
+}
+
+/**
+ * @brief Devuelve una referencia al vértice indicado.
+ *
+ * Esta función puede ser utilizada con las operaciones @see Vertex_Start(), @see Vertex_End(), @see Vertex_Next().
+ *
+ * @param g          Un grafo
+ * @param vertex_idx El índice del vértice del cual queremos devolver la referencia.
+ *
+ * @return La referencia al vértice vertex_idx.
+ */
+Vertex* Graph_GetVertexByIndex( const Graph* g, int vertex_idx )
+{
+   assert( 0 <= vertex_idx && vertex_idx < g->len );
+
+   return &(g->vertices[ vertex_idx ] );
+}
+
+/**
+ * @brief Devuelve el índice del vértice cuyo id es |vertex_val|.
+ *
+ * @param g          Un grafo.
+ * @param vertex_val El id del aeropuerto a buscar.
+ *
+ * @return El índice del vértice; -1 si no existe.
+ */
+int Graph_getIndexByValue(Graph* g, int vertex_val)
+{
+   return find( g, vertex_val );
+}
+ 
+bool is_Neighbor_Of( const Graph* g, int dest, int src)
+{
+   assert( g->len > 0 );
+
+   // obtenemos los índices correspondientes:
+   int src_idx = find( g, src );
+   int dest_idx = find( g, dest );
+
+    if( src_idx == -1 || dest_idx == -1 ) return false;
+   // uno o ambos vértices no existen
+
+   return find_neighbor( &g->vertices[ src_idx ], dest_idx ) != NULL;
+}
+
+/**
+ * @brief Responde un lote de preguntas "¿hay ruta directa de src[i] a dst[i]?".
+ *
+ * Equivale a llamar is_Neighbor_Of( g, dst[ i ], src[ i ] ) para cada par,
+ * pero agrupa los pares por vértice de salida (ordenamiento por conteo) y
+ * responde cada grupo de una vez: se marcan los vecinos del vértice en una sola
+ * pasada por su lista y cada par del grupo se revisa contra la marca. Si el
+ * grupo es chico comparado con el grado y el vértice tiene conjunto de vecinos
+ * (ver VERTEX_SET_MIN_DEGREE), cada par se busca en el conjunto en O(1). Así un
+ * vértice nunca se recorre más de una vez por lote.
+ *
+ * @param g      El grafo.
+ * @param src    Ids de los vértices de salida.
+ * @param dst    Ids de los vértices de llegada.
+ * @param n      Número de pares.
+ * @param result Recibe la respuesta de cada par (false si uno de los ids no existe).
+ *
+ * @return El número de pares con ruta directa; -1 si no hubo memoria (y
+ * |result| queda indefinido).
+ */
+int Graph_AreNeighbors( const Graph* g, const int src[], const int dst[], int n, bool result[] )
+{
+   typedef struct { int src; int dst; int pos; } Query;
+
+   Query* a = (Query*) malloc( ( n > 0 ? n : 1 ) * sizeof( Query ) );
+   Query* b = (Query*) malloc( ( n > 0 ? n : 1 ) * sizeof( Query ) );
+   int* count = (int*) malloc( ( g->len + 1 ) * sizeof( int ) );
+
+   if( !a || !b || !count )
+   {
+      free( a );
+      free( b );
+      free( count );
+      return -1;
+   }
+
+   int m = 0;
+   for( int i = 0; i < n; ++i )
+   {
+      result[ i ] = false;
+
+      int s = find( g, src[ i ] );
+      int d = s == -1 ? -1 : find( g, dst[ i ] );
+      if( d == -1 ) continue;
+      // uno o ambos vértices no existen
+
+      a[ m ].src = s; a[ m ].dst = d; a[ m ].pos = i; ++m;
+   }
+
+   memset( count, 0, ( g->len + 1 ) * sizeof( int ) );
+   for( int i = 0; i < m; ++i ) ++count[ a[ i ].src + 1 ];
+   for( int v = 0; v < g->len; ++v ) count[ v + 1 ] += count[ v ];
+   for( int i = 0; i < m; ++i ) b[ count[ a[ i ].src ]++ ] = a[ i ];
+
+   // tras el ordenamiento |count| sólo tiene valores >= 0, así que sirve de
+   // arreglo de marcas: el grupo k marca a los vecinos de su vértice con -(k+1)
+   // y no hace falta limpiarlo entre grupos
+   int* mark = count;
+
+   int found = 0;
+   for( int i = 0, k = 0; i < m; ++k )
+   {
+      const Vertex* vertex = &g->vertices[ b[ i ].src ];
+
+      int j = i;
+      while( j < m && b[ j ].src == b[ i ].src ) ++j;
+
+      if( j - i == 1 || ( vertex->neighbor_set && j - i < vertex->degree / 4 ) )
+      {
+         for( ; i < j; ++i )
+         {
+            result[ b[ i ].pos ] = find_neighbor( vertex, b[ i ].dst ) != NULL;
+            found += result[ b[ i ].pos ];
+         }
+      }
+      else
+      {
+         int stamp = -( k + 1 );
+         if( vertex->neighbors )
+         {
+            for( Node* it = vertex->neighbors->first; it; it = it->next ) mark[ it->data.index ] = stamp;
+         }
+
+         for( ; i < j; ++i )
+         {
+            result[ b[ i ].pos ] = mark[ b[ i ].dst ] == stamp;
+            found += result[ b[ i ].pos ];
+         }
+      }
+   }
+
+   free( a );
+   free( b );
+   free( count );
+   return found;
+}
+
+/**
+ * @brief Empaca un código IATA en una llave entera sin comparar cadenas.
+ *
+ * @param iata Un código IATA.
+ *
+ * @return La llave (base 26, menor que IATA_INDEX_SIZE); -1 si el código no
+ * consiste en exactamente 3 letras mayúsculas.
+ */
+int Graph_IataKey( const char iata[] )
+{
+   unsigned a = (unsigned)( iata[ 0 ] - 'A' );
+   if( a >= 26 ) return -1;
+   unsigned b = (unsigned)( iata[ 1 ] - 'A' );
+   if( b >= 26 ) return -1;
+   unsigned c = (unsigned)( iata[ 2 ] - 'A' );
+   if( c >= 26 || iata[ 3 ] != '\0' ) return -1;
+
+   return (int)( ( a * 26 + b ) * 26 + c );
+}
+
+/**
+ * @brief Devuelve el índice del vértice con el código IATA indicado.
+ *
+ * La búsqueda es O(1): el código de 3 letras se empaca en una llave que indexa
+ * directamente una tabla, sin comparar cadenas.
+ *
+ * @param g    Un grafo.
+ * @param iata Código IATA de 3 letras mayúsculas, p.ej. "MEX".
+ *
+ * @return El índice del vértice; -1 si no existe o si el código no es válido.
+ */
+int Graph_GetIndexByIata( const Graph* g, const char iata[] )
+{
+   int key = Graph_IataKey( iata );
+   return key != -1 ? g->iata_index[ key ] : -1;
+}
+
+/**
+ * @brief Devuelve una referencia al vértice con el código IATA indicado.
+ *
+ * @param g    Un grafo.
+ * @param iata Código IATA de 3 letras mayúsculas, p.ej. "MEX".
+ *
+ * @return La referencia al vértice; NULL si no existe.
+ */
+Vertex* Graph_GetVertexByIata( const Graph* g, const char iata[] )
+{
+   int idx = Graph_GetIndexByIata( g, iata );
+   return idx != -1 ? &g->vertices[ idx ] : NULL;
+}
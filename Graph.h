@@ -0,0 +1,211 @@
+#ifndef  GRAPH_INC
+#define  GRAPH_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "List.h"
+#include "StrPool.h"
+
+// Aunque en este ejemplo estamos usando tipos básicos, vamos a usar al alias |Item| para resaltar
+// aquellos lugares donde estamos hablando de DATOS y no de índices.
+typedef int Item;
+
+/**
+ * @brief La información completa de un aeropuerto, en un solo registro.
+ *
+ * El grafo no la guarda así, sino repartida en arreglos paralelos (ver Graph);
+ * Graph_GetData() la arma. La copia CSR y los snapshots sí guardan el registro.
+ */
+typedef struct
+{
+   int id;
+   int utc_time;
+   char iata_code[4];
+   char country[65];
+   char city[65];
+   char name[65];
+   float latitude;  ///< grados; NAN si no se conoce
+   float longitude; ///< grados; NAN si no se conoce
+
+} Data;
+
+
+//----------------------------------------------------------------------
+//                           Vertex stuff:
+//----------------------------------------------------------------------
+
+
+/**
+ * @brief Grado a partir del cual un vértice mantiene, además de su lista, un
+ * conjunto (hash) de vecinos para detectar aristas duplicadas en O(1).
+ */
+#ifndef VERTEX_SET_MIN_DEGREE
+#define VERTEX_SET_MIN_DEGREE 16
+#endif
+
+/**
+ * @brief Declara lo que es un vértice: su adyacencia. Los atributos del
+ * aeropuerto viven en los arreglos paralelos del grafo, con el mismo índice.
+ */
+typedef struct
+{
+   List* neighbors;
+
+   int degree;          ///< Número de vecinos en la lista
+   Node** neighbor_set; ///< Nodos de la lista, dispersados por índice del vecino (direccionamiento abierto, NULL libre); NULL en vértices de grado bajo
+   int set_bits;        ///< El conjunto tiene 2^set_bits entradas
+   bool removed;        ///< El vértice fue borrado (lápida); ver Graph_RemoveVertex()
+} Vertex;
+
+List_Iterator Vertex_Begin( const Vertex* v );
+
+void Vertex_Start( Vertex* v );
+void Vertex_Next( Vertex* v );
+bool Vertex_End( const Vertex* v );
+int Vertex_GetNeighborIndex( const Vertex* v );
+float Vertex_GetNeighborWeight( const Vertex* v );
+
+
+//----------------------------------------------------------------------
+//                           Graph stuff:
+//----------------------------------------------------------------------
+
+/** Tipo del grafo.
+ */
+typedef enum
+{
+   eGraphType_UNDIRECTED, ///< grafo no dirigido
+   eGraphType_DIRECTED    ///< grafo dirigido (digraph)
+} eGraphType;
+
+/**
+ * @brief Una entrada del índice (hash) de llaves a índices de vértices.
+ */
+typedef struct
+{
+   int key;   ///< el id del aeropuerto
+   int index; ///< índice en la lista de vértices; -1 si la entrada está libre
+} IndexSlot;
+
+/**
+ * @brief Número de entradas del índice por código IATA: uno por cada código
+ * posible de 3 letras mayúsculas (26^3).
+ */
+#define IATA_INDEX_SIZE ( 26 * 26 * 26 )
+
+/**
+ * @brief Declara lo que es un grafo.
+ *
+ * Los atributos de los vértices se guardan como estructura de arreglos: un
+ * arreglo por campo, todos indexados por el índice del vértice. Un recorrido
+ * que sólo lee ids (o códigos IATA, o ubicaciones) lee memoria contigua en
+ * lugar de saltar de registro en registro. País, ciudad y nombre se guardan
+ * una sola vez en |strings| y cada vértice guarda sólo su referencia.
+ *
+ * Los arreglos crecen solos; ver Graph_AddVertex() para saber qué referencias
+ * invalida una inserción.
+ */
+typedef struct
+{
+   Vertex* vertices;       ///< Adyacencia de cada vértice
+   int* ids;               ///< id del aeropuerto
+   int* utc_times;         ///< diferencia con UTC, en horas
+   char (*iata_codes)[4];  ///< código IATA (cadena vacía si no tiene)
+   float* latitudes;       ///< grados; NAN si no se conoce
+   float* longitudes;      ///< grados; NAN si no se conoce
+   StrRef* countries;      ///< referencias a |strings|
+   StrRef* cities;
+   StrRef* names;
+   StrPool strings;        ///< textos sin repetir
+
+   int size;      ///< Capacidad actual de los arreglos de vértices
+
+   IndexSlot* id_index; ///< Tabla hash (direccionamiento abierto) de id a índice
+   int id_bits;         ///< La tabla tiene 2^id_bits entradas
+
+   int* iata_index; ///< Índice directo de código IATA a índice; -1 si no existe
+
+   /**
+    * Número de lugares ocupados en la lista de vértices, incluyendo a los
+    * vértices borrados (lápidas) hasta la siguiente llamada a Graph_Compact().
+    * Lo usamos como índice en la función de inserción.
+    */
+   int len;
+   int removed; ///< Número de lápidas entre los primeros |len| lugares
+
+   eGraphType type; ///< tipo del grafo, UNDIRECTED o DIRECTED
+
+   unsigned version; ///< Aumenta con cada modificación del grafo; sirve para invalidar resultados guardados
+} Graph;
+
+Graph* Graph_New( int size, eGraphType type );
+void Graph_Delete( Graph** g );
+void Graph_Print( const Graph* g, int depth );
+
+bool Graph_AddVertex( Graph* g, int id, const char iata[], const char country[], const char city[], const char name[], int utc );
+bool Graph_AddEdge( Graph* g, int start, int finish );
+bool Graph_AddWeightedEdge( Graph* g, int start, int finish, float peso );
+bool Graph_SetEdgeWeight( Graph* g, int start, int finish, float peso );
+int Graph_AddEdgesByIndex( Graph* g, const int src[], const int dst[], const float weights[], int n );
+bool Graph_SetLocation( Graph* g, int id, float latitude, float longitude );
+
+bool Graph_RemoveEdge( Graph* g, int start, int finish );
+bool Graph_RemoveVertex( Graph* g, int id );
+int Graph_Compact( Graph* g, int old_to_new[] );
+
+/**
+ * @brief Indica si el vértice fue borrado. Los recorridos sobre un grafo
+ * dirigido lo usan para saltar las aristas que llegaban a un vértice borrado.
+ */
+static inline bool Graph_IsRemoved( const Graph* g, int vertex_idx )
+{
+   return g->vertices[ vertex_idx ].removed;
+}
+
+int Graph_GetSize( Graph* g );
+int Graph_GetLen( Graph* g );
+Item Graph_GetDataByIndex( const Graph* g, int vertex_idx );
+Data Graph_GetData( const Graph* g, int vertex_idx );
+Vertex* Graph_GetVertexByIndex( const Graph* g, int vertex_idx );
+int Graph_getIndexByValue( Graph* g, int vertex_val );
+
+int Graph_IataKey( const char iata[] );
+int Graph_GetIndexByIata( const Graph* g, const char iata[] );
+Vertex* Graph_GetVertexByIata( const Graph* g, const char iata[] );
+
+bool is_Neighbor_Of( const Graph* g, int dest, int src );
+int Graph_AreNeighbors( const Graph* g, const int src[], const int dst[], int n, bool result[] );
+
+/**
+ * @brief Devuelve el código IATA del vértice (cadena vacía si no tiene).
+ */
+static inline const char* Graph_GetIata( const Graph* g, int vertex_idx )
+{
+   return g->iata_codes[ vertex_idx ];
+}
+
+/**
+ * @brief Devuelven el país, la ciudad y el nombre del aeropuerto.
+ *
+ * @warning Los textos viven en un almacén que puede cambiar de lugar, así que
+ * el apuntador sólo es válido hasta la siguiente llamada a Graph_AddVertex() o
+ * Graph_Compact().
+ */
+static inline const char* Graph_GetCountry( const Graph* g, int vertex_idx )
+{
+   return StrPool_Get( &g->strings, g->countries[ vertex_idx ] );
+}
+
+static inline const char* Graph_GetCity( const Graph* g, int vertex_idx )
+{
+   return StrPool_Get( &g->strings, g->cities[ vertex_idx ] );
+}
+
+static inline const char* Graph_GetName( const Graph* g, int vertex_idx )
+{
+   return StrPool_Get( &g->strings, g->names[ vertex_idx ] );
+}
+
+#endif   /* ----- #ifndef GRAPH_INC  ----- */
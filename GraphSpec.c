@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "GraphSpec.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// Las funciones de esta sección no dependen de la variante; las de cada
+// variante (GRAPH_SPEC_DEFINE) las comparten.
+
+// ret: la posición inicial de búsqueda en una tabla de 2^bits entradas (Fibonacci hashing)
+static int hash_index( int key, int bits )
+{
+   return (int)( ( (uint32_t) key * 2654435769u ) >> ( 32 - bits ) );
+}
+
+// el conjunto guarda índice + 1, de manera que 0 marca una entrada libre
+static bool set_contains( const int* set, int bits, int key )
+{
+   int mask = ( 1 << bits ) - 1;
+   for( int i = hash_index( key, bits ); set[ i ]; i = ( i + 1 ) & mask )
+   {
+      if( set[ i ] == key + 1 ) return true;
+   }
+   return false;
+}
+
+static void set_put( int* set, int bits, int key )
+{
+   int mask = ( 1 << bits ) - 1;
+   int i = hash_index( key, bits );
+   while( set[ i ] ) i = ( i + 1 ) & mask;
+   set[ i ] = key + 1;
+}
+
+// vuelve a crear el conjunto con los |n| vecinos, a lo más a media carga
+// ret: false si no hubo memoria (el conjunto anterior queda intacto)
+static bool set_rebuild( int** p_set, int* p_bits, const int* neighbors, int n )
+{
+   int bits = 1;
+   while( ( 1 << bits ) < 4 * n ) ++bits;
+
+   int* set = (int*) calloc( 1 << bits, sizeof( int ) );
+   if( !set ) return false;
+
+   for( int k = 0; k < n; ++k ) set_put( set, bits, neighbors[ k ] );
+
+   free( *p_set );
+   *p_set = set;
+   *p_bits = bits;
+   return true;
+}
+
+// busca |v| entre los vecinos: en el conjunto si existe, si no en el arreglo
+static bool has_neighbor( const int* neighbors, int degree, const int* set, int bits, int v )
+{
+   if( set ) return set_contains( set, bits, v );
+
+   for( int k = 0; k < degree; ++k )
+   {
+      if( neighbors[ k ] == v ) return true;
+   }
+   return false;
+}
+
+/**
+ * @brief Define las funciones de la variante |T| declarada con
+ * GRAPH_SPEC_DECLARE( T, DIRECTED, WEIGHTED ). DIRECTED y WEIGHTED son
+ * constantes, así que el compilador elimina las ramas que no aplican.
+ */
+#define GRAPH_SPEC_DEFINE( T, DIRECTED, WEIGHTED )                                    \
+                                                                                      \
+T* T##_New( int size )                                                                \
+{                                                                                     \
+   T* g = (T*) calloc( 1, sizeof( T ) );                                              \
+   if( !g ) return NULL;                                                              \
+                                                                                      \
+   g->size = size > 0 ? size : 1;                                                     \
+   g->vertices = (T##Vertex*) calloc( g->size, sizeof( T##Vertex ) );                 \
+   if( !g->vertices )                                                                 \
+   {                                                                                  \
+      free( g );                                                                      \
+      return NULL;                                                                    \
+   }                                                                                  \
+   return g;                                                                          \
+}                                                                                     \
+                                                                                      \
+void T##_Delete( T** p_g )                                                            \
+{                                                                                     \
+   assert( *p_g );                                                                    \
+                                                                                      \
+   T* g = *p_g;                                                                       \
+   for( int i = 0; i < g->len; ++i )                                                  \
+   {                                                                                  \
+      free( g->vertices[ i ].neighbors );                                             \
+      GRAPH_SPEC_IF( WEIGHTED, free( g->vertices[ i ].weights ); )                    \
+      free( g->vertices[ i ].set );                                                   \
+   }                                                                                  \
+   free( g->vertices );                                                               \
+   free( g );                                                                         \
+   *p_g = NULL;                                                                       \
+}                                                                                     \
+                                                                                      \
+int T##_AddVertex( T* g )                                                             \
+{                                                                                     \
+   if( g->len == g->size )                                                            \
+   {                                                                                  \
+      T##Vertex* vertices = (T##Vertex*) realloc( g->vertices, 2 * g->size * sizeof( T##Vertex ) ); \
+      if( !vertices ) return -1;                                                      \
+                                                                                      \
+      g->vertices = vertices;                                                         \
+      g->size *= 2;                                                                   \
+   }                                                                                  \
+                                                                                      \
+   memset( &g->vertices[ g->len ], 0, sizeof( T##Vertex ) );                          \
+   return g->len++;                                                                   \
+}                                                                                     \
+                                                                                      \
+static bool T##_push( T* g, int u, int v GRAPH_SPEC_IF( WEIGHTED, , float weight ) )  \
+{                                                                                     \
+   T##Vertex* x = &g->vertices[ u ];                                                  \
+   if( has_neighbor( x->neighbors, x->degree, x->set, x->set_bits, v ) ) return false; \
+                                                                                      \
+   if( x->degree == x->cap )                                                          \
+   {                                                                                  \
+      int cap = x->cap > 0 ? 2 * x->cap : 4;                                          \
+      int* neighbors = (int*) realloc( x->neighbors, cap * sizeof( int ) );           \
+      if( !neighbors ) return false;                                                  \
+      x->neighbors = neighbors;                                                       \
+                                                                                      \
+      GRAPH_SPEC_IF( WEIGHTED,                                                        \
+      float* weights = (float*) realloc( x->weights, cap * sizeof( float ) );         \
+      if( !weights ) return false;                                                    \
+      x->weights = weights;                                                           \
+      )                                                                               \
+      x->cap = cap;                                                                   \
+   }                                                                                  \
+                                                                                      \
+   x->neighbors[ x->degree ] = v;                                                     \
+   GRAPH_SPEC_IF( WEIGHTED, x->weights[ x->degree ] = weight; )                       \
+   ++x->degree;                                                                       \
+   ++g->edges;                                                                        \
+                                                                                      \
+   if( x->set && 2 * x->degree <= ( 1 << x->set_bits ) )                              \
+   {                                                                                  \
+      set_put( x->set, x->set_bits, v );                                              \
+   }                                                                                  \
+   else if( x->degree >= VERTEX_SET_MIN_DEGREE )                                      \
+   {                                                                                  \
+      if( !set_rebuild( &x->set, &x->set_bits, x->neighbors, x->degree ) )            \
+      {                                                                               \
+         free( x->set );                                                              \
+         x->set = NULL;                                                               \
+      }                                                                               \
+   }                                                                                  \
+   return true;                                                                       \
+}                                                                                     \
+                                                                                      \
+/* deshace el último T##_push( g, u, ... ) */                                        \
+static void T##_pop( T* g, int u )                                                    \
+{                                                                                     \
+   T##Vertex* x = &g->vertices[ u ];                                                  \
+   --x->degree;                                                                       \
+   --g->edges;                                                                        \
+                                                                                      \
+   if( x->set && ( x->degree < VERTEX_SET_MIN_DEGREE ||                               \
+       !set_rebuild( &x->set, &x->set_bits, x->neighbors, x->degree ) ) )             \
+   {                                                                                  \
+      free( x->set );                                                                 \
+      x->set = NULL;                                                                  \
+   }                                                                                  \
+}                                                                                     \
+                                                                                      \
+bool T##_AddEdge( T* g, int u, int v GRAPH_SPEC_IF( WEIGHTED, , float weight ) )      \
+{                                                                                     \
+   assert( 0 <= u && u < g->len );                                                    \
+   assert( 0 <= v && v < g->len );                                                    \
+                                                                                      \
+   if( !T##_push( g, u, v GRAPH_SPEC_IF( WEIGHTED, , weight ) ) ) return false;       \
+                                                                                      \
+   if( !DIRECTED && u != v && !T##_push( g, v, u GRAPH_SPEC_IF( WEIGHTED, , weight ) ) ) \
+   {                                                                                  \
+      T##_pop( g, u );                                                                \
+      return false;                                                                   \
+   }                                                                                  \
+   return true;                                                                       \
+}                                                                                     \
+                                                                                      \
+bool T##_HasEdge( const T* g, int u, int v )                                          \
+{                                                                                     \
+   assert( 0 <= u && u < g->len );                                                    \
+                                                                                      \
+   const T##Vertex* x = &g->vertices[ u ];                                            \
+   return has_neighbor( x->neighbors, x->degree, x->set, x->set_bits, v );            \
+}                                                                                     \
+                                                                                      \
+size_t T##_Bytes( const T* g )                                                        \
+{                                                                                     \
+   size_t bytes = sizeof( T ) + g->size * sizeof( T##Vertex );                        \
+   for( int i = 0; i < g->len; ++i )                                                  \
+   {                                                                                  \
+      const T##Vertex* x = &g->vertices[ i ];                                         \
+      bytes += x->cap * sizeof( int );                                                \
+      GRAPH_SPEC_IF( WEIGHTED, bytes += x->cap * sizeof( float ); )                   \
+      if( x->set ) bytes += ( (size_t) 1 << x->set_bits ) * sizeof( int );            \
+   }                                                                                  \
+   return bytes;                                                                      \
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+// Cada variante define T_New(), T_Delete(), T_AddVertex(), T_AddEdge(),
+// T_HasEdge() y T_Bytes():
+//
+// T_New( size ): crea un grafo vacío con capacidad para |size| vértices; NULL
+//    si no hubo memoria. Se libera con T_Delete( &g ), que deja g en NULL.
+//
+// T_AddVertex( g ): agrega un vértice sin vecinos; devuelve su índice (0, 1,
+//    2, ...) o -1 si no hubo memoria.
+//
+// T_AddEdge( g, u, v[, weight] ): agrega la arista u -> v entre índices
+//    válidos (en las variantes no dirigidas también v -> u); false si ya
+//    existía o si no hubo memoria, y en ese caso el grafo queda sin cambios.
+//
+// T_HasEdge( g, u, v ): true si existe la arista u -> v. O(1) en los vértices
+//    de grado alto.
+//
+// T_Bytes( g ): bytes de memoria dinámica que ocupa el grafo.
+
+GRAPH_SPEC_DEFINE( UGraph, 0, 0 )
+GRAPH_SPEC_DEFINE( UGraphW, 0, 1 )
+GRAPH_SPEC_DEFINE( DiGraph, 1, 0 )
+GRAPH_SPEC_DEFINE( DiGraphW, 1, 1 )
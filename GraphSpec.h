@@ -0,0 +1,108 @@
+#ifndef  GRAPHSPEC_INC
+#define  GRAPHSPEC_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "Graph.h"
+
+/**
+ * @brief Variantes del grafo especializadas al compilar.
+ *
+ * Graph decide en tiempo de ejecución si es dirigido (g->type) y siempre guarda
+ * un peso por arista. Las variantes de este archivo se generan con macros para
+ * cada combinación de dirigido/no dirigido y con/sin peso:
+ *
+ *    UGraph    no dirigido, sin peso
+ *    UGraphW   no dirigido, con peso
+ *    DiGraph   dirigido, sin peso
+ *    DiGraphW  dirigido, con peso
+ *
+ * En cada una el tipo es una constante, así que la inserción y los recorridos
+ * no tienen ramas por tipo, y las variantes sin peso no guardan el arreglo de
+ * pesos. Sólo guardan la adyacencia, por índice de vértice, en un arreglo
+ * contiguo por vértice (los vértices de grado alto tienen además un conjunto
+ * hash, como en Graph; ver VERTEX_SET_MIN_DEGREE). No hay borrados ni
+ * atributos de aeropuerto: sirven para construir y analizar redes grandes.
+ *
+ * Ejemplo
+ * @code
+   DiGraphW* g = DiGraphW_New( 100 );
+   int a = DiGraphW_AddVertex( g );
+   int b = DiGraphW_AddVertex( g );
+   DiGraphW_AddEdge( g, a, b, 90.0f );
+
+   const int* nbrs = DiGraphW_Neighbors( g, a );
+   const float* w = DiGraphW_Weights( g, a );
+   for( int k = 0; k < DiGraphW_Degree( g, a ); ++k )
+   {
+      // nbrs[ k ] es el índice del vecino y w[ k ] el peso de la arista
+   }
+   DiGraphW_Delete( &g );
+   @endcode
+ */
+
+// expansión condicional: GRAPH_SPEC_IF( 1, x ) -> x; GRAPH_SPEC_IF( 0, x ) -> nada.
+// |cond| debe ser el literal 0 o 1
+#define GRAPH_SPEC_IF( cond, ... ) GRAPH_SPEC_IF_##cond( __VA_ARGS__ )
+#define GRAPH_SPEC_IF_0( ... )
+#define GRAPH_SPEC_IF_1( ... ) __VA_ARGS__
+
+/**
+ * @brief Declara la variante |T| del grafo: los tipos T y TVertex, y las
+ * funciones T_*. DIRECTED y WEIGHTED son los literales 0 o 1.
+ */
+#define GRAPH_SPEC_DECLARE( T, DIRECTED, WEIGHTED )                                   \
+                                                                                      \
+typedef struct                                                                        \
+{                                                                                     \
+   int* neighbors; /* índices de los vecinos */                                       \
+   GRAPH_SPEC_IF( WEIGHTED, float* weights; /* peso de cada arista */ )               \
+   int degree;                                                                        \
+   int cap;        /* capacidad de los arreglos */                                    \
+   int* set;       /* índice + 1 de cada vecino, dispersado; NULL en grado bajo */    \
+   int set_bits;   /* el conjunto tiene 2^set_bits entradas */                        \
+} T##Vertex;                                                                          \
+                                                                                      \
+typedef struct                                                                        \
+{                                                                                     \
+   T##Vertex* vertices;                                                               \
+   int len;   /* número de vértices */                                                \
+   int size;  /* capacidad de |vertices| */                                           \
+   long edges; /* aristas (las de un grafo no dirigido cuentan dos veces) */          \
+} T;                                                                                  \
+                                                                                      \
+T* T##_New( int size );                                                               \
+void T##_Delete( T** p_g );                                                           \
+int T##_AddVertex( T* g );                                                            \
+bool T##_AddEdge( T* g, int u, int v GRAPH_SPEC_IF( WEIGHTED, , float weight ) );     \
+bool T##_HasEdge( const T* g, int u, int v );                                         \
+size_t T##_Bytes( const T* g );                                                       \
+                                                                                      \
+static inline int T##_Degree( const T* g, int v )                                     \
+{                                                                                     \
+   assert( 0 <= v && v < g->len );                                                    \
+   return g->vertices[ v ].degree;                                                    \
+}                                                                                     \
+                                                                                      \
+static inline const int* T##_Neighbors( const T* g, int v )                           \
+{                                                                                     \
+   assert( 0 <= v && v < g->len );                                                    \
+   return g->vertices[ v ].neighbors;                                                 \
+}                                                                                     \
+                                                                                      \
+GRAPH_SPEC_IF( WEIGHTED,                                                              \
+static inline const float* T##_Weights( const T* g, int v )                           \
+{                                                                                     \
+   assert( 0 <= v && v < g->len );                                                    \
+   return g->vertices[ v ].weights;                                                   \
+}                                                                                     \
+)
+
+GRAPH_SPEC_DECLARE( UGraph, 0, 0 )
+GRAPH_SPEC_DECLARE( UGraphW, 0, 1 )
+GRAPH_SPEC_DECLARE( DiGraph, 1, 0 )
+GRAPH_SPEC_DECLARE( DiGraphW, 1, 1 )
+
+#endif   /* ----- #ifndef GRAPHSPEC_INC  ----- */
@@ -1,12 +1,67 @@
 
 #include "List.h"
 
-static Node* new_node( int index, float weight )
+// tamaño del primer bloque de nodos de una lista y tope de crecimiento de los bloques
+#define CHUNK_MIN 4
+#define CHUNK_MAX 4096
+
+// toma un nodo libre de la lista; reserva un bloque nuevo (del doble de tamaño
+// que el anterior) sólo cuando no quedan nodos
+static Node* alloc_node( List* list )
+{
+   if( list->free_nodes )
+   {
+      Node* n = list->free_nodes;
+      list->free_nodes = n->next;
+      return n;
+   }
+
+   NodeChunk* chunk = list->chunks;
+   if( !chunk || chunk->used == chunk->cap )
+   {
+      int cap = chunk ? chunk->cap * 2 : CHUNK_MIN;
+      if( cap > CHUNK_MAX ) cap = CHUNK_MAX;
+
+      chunk = (NodeChunk*) malloc( sizeof( NodeChunk ) + cap * sizeof( Node ) );
+      if( !chunk ) return NULL;
+
+      chunk->next = list->chunks;
+      chunk->cap = cap;
+      chunk->used = 0;
+      list->chunks = chunk;
+   }
+
+   return &chunk->nodes[ chunk->used++ ];
+}
+
+// devuelve el nodo a la lista de nodos libres de |list|
+static void release_node( List* list, Node* n )
+{
+   n->next = list->free_nodes;
+   list->free_nodes = n;
+}
+
+// desconecta a |n| de la lista y lo devuelve a los nodos libres. Si el cursor
+// apuntaba a |n|, pasa al siguiente (o al primero si |n| era el último)
+static void unlink_node( List* list, Node* n )
 {
-   Node* n = (Node*) malloc( sizeof( Node ) );
+   if( n->prev ) n->prev->next = n->next;
+   else list->first = n->next;
+
+   if( n->next ) n->next->prev = n->prev;
+   else list->last = n->prev;
+
+   if( list->cursor == n ) list->cursor = n->next ? n->next : list->first;
+
+   release_node( list, n );
+}
+
+static Node* new_node( List* list, int index, float weight )
+{
+   Node* n = alloc_node( list );
    if( n != NULL )
    {
-      n->data.id = index;
+      n->data.index = index;
       n->data.weight = weight;
 
       n->next = NULL;
@@ -23,6 +78,8 @@ List* List_New()
    if( lst )
    {
       lst->first = lst->last = lst->cursor = NULL;
+      lst->chunks = NULL;
+      lst->free_nodes = NULL;
    }
 
    return lst;
@@ -32,9 +89,13 @@ void List_Delete( List** p_list )
 {
    assert( *p_list );
 
-   while( (*p_list)->first )
+   // los nodos viven en los bloques, así que basta con liberar éstos
+   NodeChunk* chunk = (*p_list)->chunks;
+   while( chunk )
    {
-      List_Pop_back( *p_list );
+      NodeChunk* next = chunk->next;
+      free( chunk );
+      chunk = next;
    }
 
    free( *p_list );
@@ -43,7 +104,7 @@ void List_Delete( List** p_list )
 
 void List_Push_back( List* list, int data, float weight )
 {
-   Node* n = new_node( data, weight );
+   Node* n = new_node( list, data, weight );
    assert( n );
 
    if( list->first != NULL )
@@ -66,13 +127,13 @@ void List_Pop_back( List* list )
    if( list->last != list->first )
    {
       Node* x = list->last->prev;
-      free( list->last );
+      release_node( list, list->last );
       x->next = NULL;
       list->last = x;
    }
    else
    {
-      free( list->last );
+      release_node( list, list->last );
       list->first = list->last = list->cursor = NULL;
    }
 
@@ -99,7 +160,7 @@ bool List_Find( List* list, int key )
    Node* start = list->first;
    while( start )
    {
-      if( start->data.id == key )
+      if( start->data.index == key )
       {
          list->cursor = start;
          return true;
@@ -110,12 +171,38 @@ bool List_Find( List* list, int key )
    return false;
 }
 
+/**
+ * @brief Elimina la primer ocurrencia con la llave key. No mueve al cursor, salvo
+ * que apuntara al elemento eliminado (ver List_Cursor_erase()).
+ *
+ * @return true si encontró (y eliminó) el elemento; false en caso contrario.
+ */
 bool List_Remove( List* list, int key )
 {
-   // terminar
+   for( Node* n = list->first; n; n = n->next )
+   {
+      if( n->data.index == key )
+      {
+         unlink_node( list, n );
+         return true;
+      }
+   }
    return false;
 }
 
+/**
+ * @brief Elimina el nodo |n| en O(1). El nodo regresa a los nodos libres de la
+ * lista y se reutiliza en la siguiente inserción.
+ *
+ * @pre |n| es un nodo de |list|.
+ */
+void List_Erase( List* list, Node* n )
+{
+   assert( n );
+
+   unlink_node( list, n );
+}
+
 void List_Cursor_front( List* list )
 {
    list->cursor = list->first;
@@ -134,8 +221,8 @@ bool List_Cursor_next( List* list )
 
 bool List_Cursor_prev( List* list )
 {
-   // terminar
-   return false;
+   list->cursor = list->cursor->prev;
+   return list->cursor;
 }
 
 bool List_Cursor_end( List* list )
@@ -143,7 +230,7 @@ bool List_Cursor_end( List* list )
    return list->cursor == NULL;
 }
 
-Data  List_Cursor_get( List* list )
+Edge List_Cursor_get( List* list )
 {
    assert( list->cursor );
 
@@ -159,7 +246,12 @@ Data  List_Cursor_get( List* list )
  * @post El cursor queda apuntando al elemento a la derecha del elemento eliminado; si
  * este hubiese sido el último, entonces el cursor apunta al primer elemento de la lista.
  */
-void List_Cursor_erase( List* list );
+void List_Cursor_erase( List* list )
+{
+   assert( list->cursor );
+
+   unlink_node( list, list->cursor );
+}
 
 
 /**
@@ -175,7 +267,7 @@ void List_For_each( List* list, void (*fn)( int, float ) )
 
    while( it != NULL )
    {
-      fn( it->data.id, it->data.weight );
+      fn( it->data.index, it->data.weight );
 
       it = it->next;
    }
@@ -8,33 +8,51 @@
 #include <stdbool.h>
 #include <assert.h>
 
+/**
+ * @brief Declara lo que es una arista en la lista de vecinos.
+ *
+ * Sólo guarda lo que la arista necesita: el índice del vértice vecino y el peso.
+ * La información del aeropuerto (|Data|) vive únicamente en el vértice. Si en
+ * el futuro las aristas necesitan más atributos (aerolínea, equipo, etc.) se
+ * agregan aquí.
+ */
 typedef struct
 {
-   int id;
-   int utc_time;
-   float weight;
-   char iata_code[4];
-   char country[65];
-   char city[65];
-   char name[65];
-
-} Data;
+   int index;    ///< índice del vecino en la lista de vértices
+   float weight; ///< peso de la arista (tiempo de vuelo)
+} Edge;
 
 
 typedef struct Node
 {
 //   int data;
-   Data data;
+   Edge data;
 
    struct Node* next;
    struct Node* prev;
 } Node;
 
+/**
+ * @brief Bloque de nodos. Los nodos de una lista se toman de bloques propios
+ * de esa lista, de manera que las aristas de un mismo vértice quedan juntas en
+ * memoria y la lista se libera con una llamada a free() por bloque.
+ */
+typedef struct NodeChunk
+{
+   struct NodeChunk* next; ///< bloque anterior (más pequeño)
+   int cap;                ///< número de nodos en el bloque
+   int used;               ///< número de nodos ya entregados
+   Node nodes[];
+} NodeChunk;
+
 typedef struct
 {
    Node* first;
    Node* last;
    Node* cursor;
+
+   NodeChunk* chunks; ///< bloques de nodos; el más reciente primero
+   Node* free_nodes;  ///< nodos devueltos por las operaciones Pop, encadenados por |next|
 } List;
 
 List* List_New();
@@ -60,6 +78,7 @@ bool List_Is_empty( List* list );
 bool List_Find( List* list, int key );
 
 bool List_Remove( List* list, int key );
+void List_Erase( List* list, Node* n );
 
 void List_Cursor_front( List* list );
 void List_Cursor_back( List* list );
@@ -74,7 +93,7 @@ bool List_Cursor_end( List* list );
  *
  * @pre El cursor debe apuntar a una posición válida.
  */
-Data List_Cursor_get( List* list );
+Edge List_Cursor_get( List* list );
 
 /**
  * @brief Elimina el elemento apuntado por el cursor.
@@ -95,4 +114,68 @@ void List_Cursor_erase( List* list );
  */
 void List_For_each( List* list, void (*fn)( int, float ) );
 
+/**
+ * @brief Iterador externo sobre una lista.
+ *
+ * Es un valor pequeño que vive en la pila del cliente. A diferencia del cursor,
+ * recorrer la lista con un iterador no escribe nada en ella, así que varios
+ * recorridos (anidados o en distintos hilos) pueden hacerse al mismo tiempo
+ * sobre la misma lista mientras nadie la modifique.
+ *
+ * Ejemplo
+ * @code
+   for( List_Iterator it = List_Begin( list ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+   {
+      Edge e = List_Iterator_get( it );
+      // ...
+   }
+   @endcode
+ */
+typedef struct
+{
+   const Node* node; ///< nodo actual; NULL al terminar el recorrido
+} List_Iterator;
+
+/**
+ * @brief Devuelve un iterador al primer elemento de la lista. |list| puede ser NULL,
+ * en cuyo caso el iterador ya está al final.
+ */
+static inline List_Iterator List_Begin( const List* list )
+{
+   List_Iterator it = { list ? list->first : NULL };
+   return it;
+}
+
+/**
+ * @brief Indica si el iterador llegó al final de la lista.
+ */
+static inline bool List_Iterator_end( List_Iterator it )
+{
+   return it.node == NULL;
+}
+
+/**
+ * @brief Mueve el iterador un elemento a la derecha.
+ *
+ * @pre El iterador no está al final.
+ */
+static inline void List_Iterator_next( List_Iterator* it )
+{
+   assert( it->node );
+
+   it->node = it->node->next;
+}
+
+/**
+ * @brief Devuelve una copia del elemento al que apunta el iterador.
+ *
+ * @pre El iterador no está al final.
+ */
+static inline Edge List_Iterator_get( List_Iterator it )
+{
+   assert( it.node );
+
+   return it.node->data;
+}
+
 #endif   /* ----- #ifndef DLL_INC  ----- */
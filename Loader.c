@@ -0,0 +1,410 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Loader.h"
+
+#ifndef DBG_HELP
+#define DBG_HELP 0
+#endif  
+
+#if DBG_HELP > 0
+#define DBG_PRINT( ... ) do{ fprintf( stderr, "DBG:" __VA_ARGS__ ); } while( 0 )
+#else
+#define DBG_PRINT( ... ) ;
+#endif  
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// archivo proyectado en memoria (sólo lectura)
+typedef struct
+{
+   const char* data;
+   size_t size;
+} Mapped;
+
+// trozo de texto dentro del archivo proyectado; no termina en '\0'
+typedef struct
+{
+   const char* p;
+   int len;
+} Span;
+
+static bool map_file( const char* path, Mapped* m )
+{
+   m->data = NULL;
+   m->size = 0;
+
+   int fd = open( path, O_RDONLY );
+   if( fd < 0 ) return false;
+
+   struct stat st;
+   if( fstat( fd, &st ) != 0 )
+   {
+      close( fd );
+      return false;
+   }
+
+   m->size = (size_t) st.st_size;
+   if( m->size > 0 )
+   {
+      void* p = mmap( NULL, m->size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0 );
+      if( p == MAP_FAILED )
+      {
+         close( fd );
+         return false;
+      }
+      madvise( p, m->size, MADV_SEQUENTIAL );
+      m->data = (const char*) p;
+   }
+
+   close( fd );
+   return true;
+}
+
+static void unmap_file( Mapped* m )
+{
+   if( m->data ) munmap( (void*) m->data, m->size );
+   m->data = NULL;
+}
+
+// número de líneas no vacías del archivo (primera pasada)
+static int count_lines( const Mapped* m )
+{
+   int lines = 0;
+   const char* p = m->data;
+   const char* end = m->data + m->size;
+
+   while( p < end )
+   {
+      const char* nl = memchr( p, '\n', end - p );
+      if( !nl ) nl = end;
+      if( nl > p && !( nl - p == 1 && *p == '\r' ) ) ++lines;
+      p = nl + 1;
+   }
+   return lines;
+}
+
+// lee el siguiente campo de la línea que empieza en |*cur| sin copiarlo. Los
+// campos entre comillas pueden contener comas; las comillas no se incluyen.
+// ret: false si ya no hay campos en la línea
+static bool next_field( const char** cur, const char* end, Span* f )
+{
+   const char* p = *cur;
+   if( p >= end || *p == '\n' ) return false;
+
+   if( *p == '"' )
+   {
+      const char* q = ++p;
+      while( q < end && *q != '\n' && !( *q == '"' && ( q + 1 == end || q[ 1 ] == ',' || q[ 1 ] == '\n' || q[ 1 ] == '\r' ) ) ) ++q;
+
+      f->p = p;
+      f->len = (int)( q - p );
+      p = q < end && *q == '"' ? q + 1 : q;
+   }
+   else
+   {
+      const char* q = p;
+      while( q < end && *q != ',' && *q != '\n' ) ++q;
+
+      f->p = p;
+      f->len = (int)( q - p );
+      if( f->len > 0 && p[ f->len - 1 ] == '\r' ) --f->len;
+      p = q;
+   }
+
+   if( p < end && *p == ',' ) ++p;
+   else if( p < end && *p == '\r' ) ++p;
+   *cur = p;
+   return true;
+}
+
+// salta al inicio de la siguiente línea
+static const char* next_line( const char* p, const char* end )
+{
+   const char* nl = memchr( p, '\n', end - p );
+   return nl ? nl + 1 : end;
+}
+
+// OpenFlights usa \N para los campos vacíos
+static bool is_null( Span f )
+{
+   return f.len == 0 || ( f.len == 2 && f.p[ 0 ] == '\\' && f.p[ 1 ] == 'N' );
+}
+
+static bool parse_int( Span f, int* out )
+{
+   int i = 0, sign = 1;
+   if( i < f.len && ( f.p[ i ] == '-' || f.p[ i ] == '+' ) ) sign = f.p[ i++ ] == '-' ? -1 : 1;
+   if( i == f.len ) return false;
+
+   long v = 0;
+   for( ; i < f.len; ++i )
+   {
+      if( f.p[ i ] < '0' || f.p[ i ] > '9' ) return false;
+      v = v * 10 + ( f.p[ i ] - '0' );
+      if( v > 2147483647L ) return false;
+   }
+   *out = (int)( sign * v );
+   return true;
+}
+
+static bool parse_float( Span f, float* out )
+{
+   int i = 0;
+   double sign = 1.0;
+   if( i < f.len && ( f.p[ i ] == '-' || f.p[ i ] == '+' ) ) sign = f.p[ i++ ] == '-' ? -1.0 : 1.0;
+
+   double v = 0.0, scale = 1.0;
+   bool digits = false, frac = false;
+   for( ; i < f.len; ++i )
+   {
+      char c = f.p[ i ];
+      if( c == '.' && !frac ) frac = true;
+      else if( c >= '0' && c <= '9' )
+      {
+         digits = true;
+         if( frac ) v += ( c - '0' ) * ( scale *= 0.1 );
+         else v = v * 10.0 + ( c - '0' );
+      }
+      else return false;
+   }
+   if( !digits ) return false;
+
+   *out = (float)( sign * v );
+   return true;
+}
+
+// copia el campo en |dst| como cadena de a lo más cap-1 caracteres
+static void span_copy( Span f, char dst[], int cap )
+{
+   int len = f.len < cap - 1 ? f.len : cap - 1;
+   if( is_null( f ) ) len = 0;
+
+   memcpy( dst, f.p, len );
+   dst[ len ] = '\0';
+}
+
+// primera pasada sobre los aeropuertos: crea los vértices
+// id_map/id_max: tabla densa de id a índice para resolver las rutas sin hash
+static Graph* load_airports( const Mapped* m, eGraphType type, int** id_map, int* id_max )
+{
+   int lines = count_lines( m );
+   Graph* g = Graph_New( lines > 0 ? lines : 1, type );
+   if( !g ) return NULL;
+
+   int max = -1;
+   const char* end = m->data + m->size;
+   for( const char* line = m->data; line < end; line = next_line( line, end ) )
+   {
+      const char* cur = line;
+      Span f[ 10 ];
+      int n = 0;
+      while( n < 10 && next_field( &cur, end, &f[ n ] ) ) ++n;
+      if( n < 10 ) continue;
+
+      // id, nombre, ciudad, país, IATA, ICAO, latitud, longitud, altitud, zona horaria
+      int id;
+      if( !parse_int( f[ 0 ], &id ) ) continue;
+
+      char name[ 65 ], city[ 65 ], country[ 65 ], iata[ 4 ];
+      span_copy( f[ 1 ], name, sizeof( name ) );
+      span_copy( f[ 2 ], city, sizeof( city ) );
+      span_copy( f[ 3 ], country, sizeof( country ) );
+      span_copy( f[ 4 ], iata, sizeof( iata ) );
+
+      float utc = 0.0f;
+      parse_float( f[ 9 ], &utc );
+
+      if( !Graph_AddVertex( g, id, iata, country, city, name, (int) lroundf( utc ) ) ) continue;
+
+      float lat, lon;
+      if( parse_float( f[ 6 ], &lat ) && parse_float( f[ 7 ], &lon ) )
+      {
+         g->latitudes[ g->len - 1 ] = lat;
+         g->longitudes[ g->len - 1 ] = lon;
+      }
+
+      if( id > max ) max = id;
+   }
+
+   // la tabla densa sólo vale la pena si los ids no están muy dispersos
+   *id_max = max;
+   *id_map = NULL;
+   if( max >= 0 && max <= 4 * g->len + 1024 )
+   {
+      int* map = (int*) malloc( ( max + 1 ) * sizeof( int ) );
+      if( map )
+      {
+         for( int i = 0; i <= max; ++i ) map[ i ] = -1;
+         for( int v = g->len - 1; v >= 0; --v )
+         {
+            int id = g->ids[ v ];
+            if( id >= 0 ) map[ id ] = v;
+            // recorremos al revés para que gane el primer vértice con cada id
+         }
+         *id_map = map;
+      }
+   }
+
+   return g;
+}
+
+// resuelve un extremo de una ruta por id o, si no hay id, por código IATA
+static int resolve( const Graph* g, const int* id_map, int id_max, Span id_field, Span iata_field )
+{
+   int id;
+   if( !is_null( id_field ) && parse_int( id_field, &id ) )
+   {
+      if( id_map ) return 0 <= id && id <= id_max ? id_map[ id ] : -1;
+      return Graph_getIndexByValue( (Graph*) g, id );
+   }
+
+   char iata[ 4 ];
+   span_copy( iata_field, iata, sizeof( iata ) );
+   return iata_field.len == 3 ? Graph_GetIndexByIata( g, iata ) : -1;
+}
+
+// segunda pasada sobre las rutas: resuelve los extremos y las inserta en lote
+static bool load_routes( Graph* g, const Mapped* m, const int* id_map, int id_max )
+{
+   int lines = count_lines( m );
+   if( lines == 0 ) return true;
+
+   int* src = (int*) malloc( lines * sizeof( int ) );
+   int* dst = (int*) malloc( lines * sizeof( int ) );
+   float* weights = (float*) malloc( lines * sizeof( float ) );
+   float* coords = (float*) malloc( 3 * g->len * sizeof( float ) + 1 );
+   if( !src || !dst || !weights || !coords )
+   {
+      free( src );
+      free( dst );
+      free( weights );
+      free( coords );
+      return false;
+   }
+
+   // copia de las ubicaciones como vectores unitarios: las rutas visitan a los
+   // aeropuertos al azar y así se trae a caché un solo renglón por extremo, y no
+   // se evalúan funciones trigonométricas por cada ruta
+   const float rad = 3.14159265358979323846f / 180.0f;
+   for( int v = 0; v < g->len; ++v )
+   {
+      float lat = g->latitudes[ v ] * rad;
+      float lon = g->longitudes[ v ] * rad;
+
+      coords[ 3 * v ] = cosf( lat ) * cosf( lon );
+      coords[ 3 * v + 1 ] = cosf( lat ) * sinf( lon );
+      coords[ 3 * v + 2 ] = sinf( lat );
+   }
+
+   int n = 0;
+   const char* end = m->data + m->size;
+   for( const char* line = m->data; line < end && n < lines; line = next_line( line, end ) )
+   {
+      const char* cur = line;
+      Span f[ 6 ];
+      int k = 0;
+      while( k < 6 && next_field( &cur, end, &f[ k ] ) ) ++k;
+      if( k < 6 ) continue;
+
+      // aerolínea, id aerolínea, IATA origen, id origen, IATA destino, id destino, ...
+      int u = resolve( g, id_map, id_max, f[ 3 ], f[ 2 ] );
+      int v = resolve( g, id_map, id_max, f[ 5 ], f[ 4 ] );
+      if( u == -1 || v == -1 ) continue;
+
+      // distancia ortodrómica a partir de la cuerda entre los vectores unitarios
+      float dx = coords[ 3 * u ] - coords[ 3 * v ];
+      float dy = coords[ 3 * u + 1 ] - coords[ 3 * v + 1 ];
+      float dz = coords[ 3 * u + 2 ] - coords[ 3 * v + 2 ];
+      float chord = sqrtf( dx * dx + dy * dy + dz * dz );
+
+      src[ n ] = u;
+      dst[ n ] = v;
+
+      // sin coordenadas (\N) la cuerda es NaN; hay que revisarla antes de
+      // fminf(), que con un NaN devuelve el otro argumento
+      if( isnan( chord ) )
+      {
+         weights[ n ] = LOADER_TAXI_HOURS;
+      }
+      else
+      {
+         float km = 2.0f * 6371.0f * asinf( fminf( chord * 0.5f, 1.0f ) );
+         weights[ n ] = km / LOADER_CRUISE_KMH + LOADER_TAXI_HOURS;
+      }
+      ++n;
+   }
+
+   DBG_PRINT( "load_routes(): %d of %d routes resolved\n", n, lines );
+
+   bool ok = Graph_AddEdgesByIndex( g, src, dst, weights, n ) >= 0;
+
+   free( src );
+   free( dst );
+   free( weights );
+   free( coords );
+   return ok;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Carga un grafo desde archivos con el formato de OpenFlights.
+ *
+ * Los archivos se proyectan en memoria y se recorren en dos pasadas: la primera
+ * cuenta líneas para crear el grafo y los arreglos de rutas del tamaño justo, y
+ * la segunda separa los campos sin copiarlos. Los extremos de las rutas se
+ * resuelven por id con una tabla densa (o por código IATA si falta el id) y
+ * las aristas se insertan en un solo lote con Graph_AddEdgesByIndex().
+ *
+ * Como las rutas no traen duración, el peso de cada arista se estima con la
+ * distancia ortodrómica entre LOADER_CRUISE_KMH más LOADER_TAXI_HOURS. La zona
+ * horaria se redondea a horas enteras. Las líneas mal formadas y las rutas
+ * hacia aeropuertos desconocidos se ignoran.
+ *
+ * @param airports_path Archivo de aeropuertos (airports.dat).
+ * @param routes_path   Archivo de rutas (routes.dat), o NULL para no cargar rutas.
+ * @param type          Tipo del grafo.
+ *
+ * @return El grafo; NULL si algún archivo no se pudo leer o no hubo memoria.
+ */
+Graph* Loader_OpenFlights( const char* airports_path, const char* routes_path, eGraphType type )
+{
+   Mapped airports, routes = { NULL, 0 };
+
+   if( !map_file( airports_path, &airports ) ) return NULL;
+   if( routes_path && !map_file( routes_path, &routes ) )
+   {
+      unmap_file( &airports );
+      return NULL;
+   }
+
+   int* id_map = NULL;
+   int id_max = -1;
+   Graph* g = load_airports( &airports, type, &id_map, &id_max );
+
+   if( g && routes.data && !load_routes( g, &routes, id_map, id_max ) )
+   {
+      Graph_Delete( &g );
+   }
+
+   free( id_map );
+   unmap_file( &airports );
+   unmap_file( &routes );
+
+   return g;
+}
@@ -0,0 +1,23 @@
+#ifndef  LOADER_INC
+#define  LOADER_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "Graph.h"
+
+/**
+ * @brief Velocidad de crucero (km/h) y tiempo fijo por vuelo (horas) con que se
+ * estima la duración de una ruta, pues los archivos de rutas no la traen.
+ */
+#ifndef LOADER_CRUISE_KMH
+#define LOADER_CRUISE_KMH 800.0f
+#endif
+
+#ifndef LOADER_TAXI_HOURS
+#define LOADER_TAXI_HOURS 0.5f
+#endif
+
+Graph* Loader_OpenFlights( const char* airports_path, const char* routes_path, eGraphType type );
+
+#endif   /* ----- #ifndef LOADER_INC  ----- */
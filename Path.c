@@ -0,0 +1,602 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Path.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+#define HEAP_ARITY 4
+
+// coloca la entrada |e| en la posición |i| del montículo y actualiza pos[]
+static void heap_set( PathScratch* s, int i, HeapEntry e )
+{
+   s->heap[ i ] = e;
+   s->pos[ e.v ] = i;
+}
+
+// sube la entrada de la posición |i| hasta restablecer la propiedad de montículo
+static void sift_up( PathScratch* s, int i )
+{
+   HeapEntry e = s->heap[ i ];
+   while( i > 0 )
+   {
+      int parent = ( i - 1 ) / HEAP_ARITY;
+      if( s->heap[ parent ].key <= e.key ) break;
+
+      heap_set( s, i, s->heap[ parent ] );
+      i = parent;
+   }
+   heap_set( s, i, e );
+}
+
+// baja la entrada de la posición |i| hasta restablecer la propiedad de montículo
+static void sift_down( PathScratch* s, int i )
+{
+   HeapEntry e = s->heap[ i ];
+   for( ;; )
+   {
+      int first = i * HEAP_ARITY + 1;
+      if( first >= s->heap_len ) break;
+
+      int last = first + HEAP_ARITY < s->heap_len ? first + HEAP_ARITY : s->heap_len;
+      int best = first;
+      for( int c = first + 1; c < last; ++c )
+      {
+         if( s->heap[ c ].key < s->heap[ best ].key ) best = c;
+      }
+
+      if( e.key <= s->heap[ best ].key ) break;
+
+      heap_set( s, i, s->heap[ best ] );
+      i = best;
+   }
+   heap_set( s, i, e );
+}
+
+// inserta |v| con llave |key|, o disminuye su llave si ya estaba en el montículo
+static void heap_push_or_decrease( PathScratch* s, int v, float key )
+{
+   int i = s->pos[ v ];
+   if( i < 0 )
+   {
+      i = s->heap_len++;
+   }
+   s->heap[ i ].key = key;
+   s->heap[ i ].v = v;
+   s->pos[ v ] = i;
+   sift_up( s, i );
+}
+
+// extrae el vértice con la menor llave y lo marca como asentado
+static int heap_pop( PathScratch* s )
+{
+   int v = s->heap[ 0 ].v;
+   s->pos[ v ] = -2;
+
+   if( --s->heap_len > 0 )
+   {
+      s->heap[ 0 ] = s->heap[ s->heap_len ];
+      sift_down( s, 0 );
+   }
+   return v;
+}
+
+// deja en su estado inicial únicamente los vértices que tocó la consulta anterior
+static void scratch_reset( PathScratch* s )
+{
+   for( int i = 0; i < s->touched_len; ++i )
+   {
+      int v = s->touched[ i ];
+      s->dist[ v ] = INFINITY;
+      s->prev[ v ] = -1;
+      s->pos[ v ] = -1;
+   }
+   s->touched_len = 0;
+   s->heap_len = 0;
+   s->settled = 0;
+}
+
+// copia en |path| el camino src -> dst siguiendo prev[]. Devuelve el número de
+// vértices del camino; si no cabe en |path_cap| sólo se devuelve la cuenta.
+static int build_path( const PathScratch* s, int dst, int path[], int path_cap )
+{
+   int count = 0;
+   for( int v = dst; v != -1; v = s->prev[ v ] ) ++count;
+
+   if( path && count <= path_cap )
+   {
+      int i = count;
+      for( int v = dst; v != -1; v = s->prev[ v ] ) path[ --i ] = v;
+   }
+   return count;
+}
+
+// inicia una búsqueda desde |src|
+static void search_start( PathScratch* s, int src, float key )
+{
+   scratch_reset( s );
+
+   s->dist[ src ] = 0.0f;
+   s->touched[ s->touched_len++ ] = src;
+   heap_push_or_decrease( s, src, key );
+}
+
+// cota inferior A* del tiempo de vuelo de |v| a |dst|; 0 si no se conoce la ubicación
+static float lower_bound( const CSR* csr, int v, int dst )
+{
+   float d = Path_DistanceKm( csr->latitude[ v ], csr->longitude[ v ],
+                              csr->latitude[ dst ], csr->longitude[ dst ] );
+
+   return isnan( d ) ? 0.0f : d / PATH_MAX_SPEED_KMH;
+}
+
+// marca de Path_RepairTree() en pos[] para los vértices del subárbol afectado
+#define AFFECTED -3
+
+// reparación: |y| mejora a |d| llegando desde |x|. Un vértice con dist = INFINITY
+// y pos = -2 es uno que la reparación dejó sin camino y ya está en touched[]
+static void repair_relax( PathScratch* s, int y, float d, int x )
+{
+   if( s->dist[ y ] == INFINITY && s->pos[ y ] == -1 ) s->touched[ s->touched_len++ ] = y;
+
+   s->dist[ y ] = d;
+   s->prev[ y ] = x;
+   heap_push_or_decrease( s, y, d );
+}
+
+// reparación: Dijkstra a partir de lo que hay en el montículo. Como el resto del
+// árbol ya es correcto, sólo avanza por los vértices que mejoran
+static void repair_propagate( const CSR* csr, PathScratch* s )
+{
+   while( s->heap_len > 0 )
+   {
+      int x = heap_pop( s );
+      ++s->settled;
+
+      float dx = s->dist[ x ];
+      const int* targets = CSR_Neighbors( csr, x );
+      const float* weights = CSR_Weights( csr, x );
+      int degree = CSR_Degree( csr, x );
+
+      for( int k = 0; k < degree; ++k )
+      {
+         float dy = dx + weights[ k ];
+         if( dy < s->dist[ targets[ k ] ] ) repair_relax( s, targets[ k ], dy, x );
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Reserva la memoria de trabajo para búsquedas sobre grafos de hasta |len| vértices.
+ *
+ * @param s   La memoria de trabajo.
+ * @param len Número de vértices del grafo (CSR::len).
+ *
+ * @return false si no hubo memoria.
+ */
+bool PathScratch_Init( PathScratch* s, int len )
+{
+   assert( len > 0 );
+
+   s->len = len;
+   s->dist = (float*) malloc( len * sizeof( float ) );
+   s->prev = (int*) malloc( len * sizeof( int ) );
+   s->pos = (int*) malloc( len * sizeof( int ) );
+   s->bound = (float*) malloc( len * sizeof( float ) );
+   s->heap = (HeapEntry*) malloc( len * sizeof( HeapEntry ) );
+   s->touched = (int*) malloc( len * sizeof( int ) );
+   s->stack = (int*) malloc( len * sizeof( int ) );
+
+   if( !s->dist || !s->prev || !s->pos || !s->bound || !s->heap || !s->touched || !s->stack )
+   {
+      PathScratch_Free( s );
+      return false;
+   }
+
+   for( int v = 0; v < len; ++v )
+   {
+      s->dist[ v ] = INFINITY;
+      s->prev[ v ] = -1;
+      s->pos[ v ] = -1;
+   }
+   s->heap_len = 0;
+   s->touched_len = 0;
+   s->settled = 0;
+
+   return true;
+}
+
+/**
+ * @brief Libera la memoria de trabajo.
+ */
+void PathScratch_Free( PathScratch* s )
+{
+   free( s->dist );
+   free( s->prev );
+   free( s->pos );
+   free( s->bound );
+   free( s->heap );
+   free( s->touched );
+   free( s->stack );
+
+   s->dist = s->bound = NULL;
+   s->prev = s->pos = s->touched = s->stack = NULL;
+   s->heap = NULL;
+   s->len = 0;
+}
+
+/**
+ * @brief Calcula el camino más rápido (suma de pesos mínima) de |src| a |dst| con
+ * el algoritmo de Dijkstra.
+ *
+ * La búsqueda termina en cuanto |dst| se asienta. Si |dst| es -1 se calculan las
+ * distancias desde |src| a todos los vértices alcanzables (quedan en s->dist).
+ * No reserva memoria: sólo usa |s|. Los pesos deben ser no negativos.
+ *
+ * @param csr      La adyacencia congelada del grafo.
+ * @param src      Índice del vértice de origen.
+ * @param dst      Índice del vértice de destino, o -1.
+ * @param s        Memoria de trabajo, con s->len >= csr->len.
+ * @param path     Arreglo donde se escribe el camino (índices de src a dst), o NULL.
+ * @param path_cap Número de entradas de |path|.
+ * @param path_len Si no es NULL, recibe el número de vértices del camino (0 si
+ *                 no hay camino). Si es mayor que |path_cap|, |path| no se escribió.
+ *
+ * @return La duración del camino; INFINITY si |dst| no es alcanzable.
+ */
+float Path_Dijkstra( const CSR* csr, int src, int dst, PathScratch* s, int path[], int path_cap, int* path_len )
+{
+   assert( s->len >= csr->len );
+   assert( 0 <= src && src < csr->len );
+   assert( -1 <= dst && dst < csr->len );
+
+   search_start( s, src, 0.0f );
+
+   while( s->heap_len > 0 )
+   {
+      int u = heap_pop( s );
+      ++s->settled;
+
+      if( u == dst ) break;
+
+      float du = s->dist[ u ];
+      const int* targets = CSR_Neighbors( csr, u );
+      const float* weights = CSR_Weights( csr, u );
+      int degree = CSR_Degree( csr, u );
+
+      for( int k = 0; k < degree; ++k )
+      {
+         int v = targets[ k ];
+         float dv = du + weights[ k ];
+
+         if( dv < s->dist[ v ] && s->pos[ v ] != -2 )
+         {
+            if( s->dist[ v ] == INFINITY ) s->touched[ s->touched_len++ ] = v;
+
+            s->dist[ v ] = dv;
+            s->prev[ v ] = u;
+            heap_push_or_decrease( s, v, dv );
+         }
+      }
+   }
+
+   if( dst == -1 )
+   {
+      if( path_len ) *path_len = 0;
+      return 0.0f;
+   }
+
+   if( s->dist[ dst ] == INFINITY )
+   {
+      if( path_len ) *path_len = 0;
+      return INFINITY;
+   }
+
+   int count = build_path( s, dst, path, path_cap );
+   if( path_len ) *path_len = count;
+
+   return s->dist[ dst ];
+}
+
+/**
+ * @brief Calcula el camino más rápido de |src| a |dst| con Dijkstra bidireccional.
+ *
+ * Busca al mismo tiempo hacia adelante desde |src| y hacia atrás desde |dst|
+ * (sobre la adyacencia inversa), expandiendo siempre el lado con la menor
+ * distancia pendiente, y termina cuando ningún camino por descubrir puede
+ * mejorar al mejor encontrado. No reserva memoria.
+ *
+ * @param csr      La adyacencia congelada del grafo.
+ * @param src      Índice del vértice de origen.
+ * @param dst      Índice del vértice de destino.
+ * @param fwd      Memoria de trabajo de la búsqueda hacia adelante.
+ * @param bwd      Memoria de trabajo de la búsqueda hacia atrás.
+ * @param path     Arreglo donde se escribe el camino (índices de src a dst), o NULL.
+ * @param path_cap Número de entradas de |path|.
+ * @param path_len Igual que en Path_Dijkstra().
+ *
+ * @return La duración del camino; INFINITY si |dst| no es alcanzable.
+ *
+ * @post fwd->settled + bwd->settled es el número de vértices asentados.
+ */
+float Path_Bidirectional( const CSR* csr, int src, int dst, PathScratch* fwd, PathScratch* bwd, int path[], int path_cap, int* path_len )
+{
+   assert( fwd->len >= csr->len && bwd->len >= csr->len );
+   assert( 0 <= src && src < csr->len );
+   assert( 0 <= dst && dst < csr->len );
+
+   search_start( fwd, src, 0.0f );
+   search_start( bwd, dst, 0.0f );
+
+   float best = src == dst ? 0.0f : INFINITY;
+   int meet = src == dst ? src : -1;
+
+   while( fwd->heap_len > 0 && bwd->heap_len > 0 &&
+          fwd->heap[ 0 ].key + bwd->heap[ 0 ].key < best )
+   {
+      bool forward = fwd->heap[ 0 ].key <= bwd->heap[ 0 ].key;
+
+      PathScratch* s = forward ? fwd : bwd;
+      const PathScratch* other = forward ? bwd : fwd;
+
+      int u = heap_pop( s );
+      ++s->settled;
+
+      float du = s->dist[ u ];
+      const int* next = forward ? CSR_Neighbors( csr, u ) : CSR_InNeighbors( csr, u );
+      const float* weights = forward ? CSR_Weights( csr, u ) : CSR_InWeights( csr, u );
+      int degree = forward ? CSR_Degree( csr, u ) : CSR_InDegree( csr, u );
+
+      for( int k = 0; k < degree; ++k )
+      {
+         int v = next[ k ];
+         float dv = du + weights[ k ];
+
+         if( dv < s->dist[ v ] && s->pos[ v ] != -2 )
+         {
+            if( s->dist[ v ] == INFINITY ) s->touched[ s->touched_len++ ] = v;
+
+            s->dist[ v ] = dv;
+            s->prev[ v ] = u;
+            heap_push_or_decrease( s, v, dv );
+         }
+
+         float through = s->dist[ v ] + other->dist[ v ];
+         if( through < best )
+         {
+            best = through;
+            meet = v;
+         }
+      }
+   }
+
+   if( meet == -1 )
+   {
+      if( path_len ) *path_len = 0;
+      return INFINITY;
+   }
+
+   // el camino es src -> meet (hacia adelante) seguido de meet -> dst (hacia atrás)
+   int head = 0, tail = 0;
+   for( int v = meet; v != -1; v = fwd->prev[ v ] ) ++head;
+   for( int v = bwd->prev[ meet ]; v != -1; v = bwd->prev[ v ] ) ++tail;
+
+   if( path && head + tail <= path_cap )
+   {
+      int i = head;
+      for( int v = meet; v != -1; v = fwd->prev[ v ] ) path[ --i ] = v;
+
+      i = head;
+      for( int v = bwd->prev[ meet ]; v != -1; v = bwd->prev[ v ] ) path[ i++ ] = v;
+   }
+   if( path_len ) *path_len = head + tail;
+
+   return best;
+}
+
+/**
+ * @brief Calcula el camino más rápido de |src| a |dst| con A*.
+ *
+ * Como Path_Dijkstra(), pero ordena la búsqueda por la duración acumulada más
+ * una cota inferior de lo que falta: la distancia ortodrómica al destino entre
+ * PATH_MAX_SPEED_KMH. Para los aeropuertos sin ubicación la cota es 0. Si un
+ * vértice ya asentado se alcanza con una duración menor se vuelve a abrir, así
+ * que el resultado es óptimo mientras la cota no sobreestime. No reserva memoria.
+ *
+ * @return La duración del camino; INFINITY si |dst| no es alcanzable.
+ */
+float Path_AStar( const CSR* csr, int src, int dst, PathScratch* s, int path[], int path_cap, int* path_len )
+{
+   assert( s->len >= csr->len );
+   assert( 0 <= src && src < csr->len );
+   assert( 0 <= dst && dst < csr->len );
+
+   s->bound[ src ] = lower_bound( csr, src, dst );
+   search_start( s, src, s->bound[ src ] );
+
+   while( s->heap_len > 0 )
+   {
+      int u = heap_pop( s );
+      ++s->settled;
+
+      if( u == dst ) break;
+
+      float du = s->dist[ u ];
+      const int* targets = CSR_Neighbors( csr, u );
+      const float* weights = CSR_Weights( csr, u );
+      int degree = CSR_Degree( csr, u );
+
+      for( int k = 0; k < degree; ++k )
+      {
+         int v = targets[ k ];
+         float dv = du + weights[ k ];
+
+         if( dv < s->dist[ v ] )
+         {
+            if( s->dist[ v ] == INFINITY )
+            {
+               s->touched[ s->touched_len++ ] = v;
+               s->bound[ v ] = lower_bound( csr, v, dst );
+            }
+
+            if( s->pos[ v ] == -2 ) s->pos[ v ] = -1;
+            // reabrimos al vértice
+
+            s->dist[ v ] = dv;
+            s->prev[ v ] = u;
+            heap_push_or_decrease( s, v, dv + s->bound[ v ] );
+         }
+      }
+   }
+
+   if( s->dist[ dst ] == INFINITY )
+   {
+      if( path_len ) *path_len = 0;
+      return INFINITY;
+   }
+
+   int count = build_path( s, dst, path, path_cap );
+   if( path_len ) *path_len = count;
+
+   return s->dist[ dst ];
+}
+
+/**
+ * @brief Repara el árbol de caminos más cortos guardado en |s| después de que
+ * cambió el peso de la arista u -> v, sin recalcularlo completo.
+ *
+ * Si el peso bajó, se propaga la mejora desde |v| sólo a los vértices cuya
+ * distancia disminuye. Si subió y la arista estaba en el árbol, se desconecta
+ * el subárbol de |v|: cada uno de sus vértices toma la mejor arista que le llega
+ * desde fuera del subárbol y se corre Dijkstra sólo sobre el subárbol. En
+ * cualquier otro caso el árbol sigue siendo válido y no se hace nada. El costo
+ * depende del tamaño de la parte afectada, no del grafo (s->settled recibe el
+ * número de vértices que se volvieron a asentar).
+ *
+ * @param csr        La adyacencia, que ya tiene el peso nuevo (ver CSR_SetEdgeWeight()).
+ * @param s          Un árbol completo: el resultado de Path_Dijkstra() con dst = -1,
+ *                   posiblemente ya reparado por llamadas anteriores.
+ * @param u          Índice del vértice de salida de la arista.
+ * @param v          Índice del vértice de llegada de la arista.
+ * @param old_weight El peso anterior de la arista.
+ * @param new_weight El peso nuevo.
+ *
+ * @post s->dist y s->prev son los de Path_Dijkstra() con los pesos nuevos (salvo
+ * empates, que pueden resolverse con otro padre).
+ *
+ * Ejemplo
+ * @code
+   Path_Dijkstra( csr, src, -1, &tree, NULL, 0, NULL );
+   // ...
+   float old = CSR_SetEdgeWeight( csr, u, v, w );
+   if( !isnan( old ) ) Path_RepairTree( csr, &tree, u, v, old, w );
+   @endcode
+ */
+void Path_RepairTree( const CSR* csr, PathScratch* s, int u, int v, float old_weight, float new_weight )
+{
+   assert( s->len >= csr->len );
+   assert( 0 <= u && u < csr->len );
+   assert( 0 <= v && v < csr->len );
+
+   s->heap_len = 0;
+   s->settled = 0;
+
+   if( s->dist[ u ] == INFINITY ) return;
+   // la arista no es alcanzable desde el origen
+
+   if( new_weight < old_weight )
+   {
+      float dv = s->dist[ u ] + new_weight;
+      if( dv < s->dist[ v ] )
+      {
+         repair_relax( s, v, dv, u );
+         repair_propagate( csr, s );
+      }
+      return;
+   }
+
+   if( new_weight == old_weight || s->prev[ v ] != u ) return;
+
+   // el subárbol de v: sus caminos usaban la arista que subió
+   int n = 0;
+   s->stack[ n++ ] = v;
+   s->pos[ v ] = AFFECTED;
+   for( int i = 0; i < n; ++i )
+   {
+      int x = s->stack[ i ];
+      const int* targets = CSR_Neighbors( csr, x );
+      for( int k = 0; k < CSR_Degree( csr, x ); ++k )
+      {
+         int y = targets[ k ];
+         if( s->prev[ y ] == x && s->pos[ y ] != AFFECTED )
+         {
+            s->pos[ y ] = AFFECTED;
+            s->stack[ n++ ] = y;
+         }
+      }
+   }
+
+   for( int i = 0; i < n; ++i )
+   {
+      s->dist[ s->stack[ i ] ] = INFINITY;
+      s->prev[ s->stack[ i ] ] = -1;
+   }
+
+   // la mejor llegada a cada vértice del subárbol desde fuera de él
+   for( int i = 0; i < n; ++i )
+   {
+      int x = s->stack[ i ];
+      const int* sources = CSR_InNeighbors( csr, x );
+      const float* weights = CSR_InWeights( csr, x );
+
+      for( int k = 0; k < CSR_InDegree( csr, x ); ++k )
+      {
+         int p = sources[ k ];
+         if( s->pos[ p ] == AFFECTED ) continue;
+
+         float d = s->dist[ p ] + weights[ k ];
+         if( d < s->dist[ x ] )
+         {
+            s->dist[ x ] = d;
+            s->prev[ x ] = p;
+         }
+      }
+   }
+
+   for( int i = 0; i < n; ++i )
+   {
+      int x = s->stack[ i ];
+      s->pos[ x ] = -2;
+      if( s->dist[ x ] < INFINITY ) heap_push_or_decrease( s, x, s->dist[ x ] );
+   }
+
+   repair_propagate( csr, s );
+}
+
+/**
+ * @brief Distancia ortodrómica (fórmula del haversine) entre dos puntos.
+ *
+ * @return La distancia en km; NAN si alguna coordenada es NAN.
+ */
+float Path_DistanceKm( float lat1, float lon1, float lat2, float lon2 )
+{
+   const double rad = 3.14159265358979323846 / 180.0;
+   const double earth_radius_km = 6371.0;
+
+   double dlat = ( lat2 - lat1 ) * rad;
+   double dlon = ( lon2 - lon1 ) * rad;
+   double a = sin( dlat / 2 ) * sin( dlat / 2 ) +
+              cos( lat1 * rad ) * cos( lat2 * rad ) * sin( dlon / 2 ) * sin( dlon / 2 );
+
+   return (float)( 2.0 * earth_radius_km * asin( sqrt( a ) ) );
+}
@@ -0,0 +1,67 @@
+#ifndef  PATH_INC
+#define  PATH_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "CSR.h"
+
+/**
+ * @brief Entrada del montículo de prioridades.
+ */
+typedef struct
+{
+   float key; ///< distancia tentativa
+   int v;     ///< vértice
+} HeapEntry;
+
+/**
+ * @brief Memoria de trabajo para las búsquedas de caminos más cortos.
+ *
+ * El cliente la reserva una sola vez con PathScratch_Init() y la reutiliza en
+ * todas sus consultas, de manera que una consulta no reserva memoria. Cada hilo
+ * debe tener la suya. Al terminar una consulta, dist[] y prev[] siguen siendo
+ * válidos para los vértices alcanzados hasta que se haga la siguiente consulta.
+ */
+typedef struct
+{
+   int len;           ///< Número de vértices para el que se reservó
+
+   float* dist;       ///< Distancia tentativa desde el origen; INFINITY si no se ha alcanzado
+   int* prev;         ///< Vértice anterior en el camino más corto; -1 si no hay
+   int* pos;          ///< Posición del vértice en el montículo; -1 si no está, -2 si ya se asentó
+   float* bound;      ///< A*: cota inferior del tiempo que falta al destino (válida si dist < INFINITY)
+
+   HeapEntry* heap;   ///< Montículo 4-ario indexado
+   int heap_len;
+
+   int* touched;      ///< Vértices modificados en la consulta actual
+   int touched_len;
+
+   int* stack;        ///< Path_RepairTree(): vértices del subárbol afectado
+
+   int settled;       ///< Número de vértices asentados en la última consulta
+} PathScratch;
+
+/**
+ * @brief Velocidad máxima (km/h) que se supone para cualquier vuelo. La distancia
+ * ortodrómica entre esta velocidad es una cota inferior del tiempo de vuelo,
+ * siempre y cuando los pesos de las aristas sean horas y ningún vuelo sea más rápido.
+ */
+#ifndef PATH_MAX_SPEED_KMH
+#define PATH_MAX_SPEED_KMH 1100.0f
+#endif
+
+bool PathScratch_Init( PathScratch* s, int len );
+void PathScratch_Free( PathScratch* s );
+
+float Path_Dijkstra( const CSR* csr, int src, int dst, PathScratch* s, int path[], int path_cap, int* path_len );
+float Path_Bidirectional( const CSR* csr, int src, int dst, PathScratch* fwd, PathScratch* bwd, int path[], int path_cap, int* path_len );
+float Path_AStar( const CSR* csr, int src, int dst, PathScratch* s, int path[], int path_cap, int* path_len );
+
+void Path_RepairTree( const CSR* csr, PathScratch* s, int u, int v, float old_weight, float new_weight );
+
+float Path_DistanceKm( float lat1, float lon1, float lat2, float lon2 );
+
+#endif   /* ----- #ifndef PATH_INC  ----- */
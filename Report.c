@@ -0,0 +1,532 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "Report.h"
+
+// espacio que se reserva por vértice antes de formatearlo, sin contar sus
+// rutas: alcanza para los tres textos escapados en JSON (64 caracteres de hasta
+// 6 bytes cada uno) más los números y las etiquetas
+#define VERTEX_BOUND 2048
+
+// espacio por ruta. En CSV cada renglón repite los datos del aeropuerto de salida
+#define ROUTE_BOUND 160
+#define CSV_ROUTE_BOUND 1024
+
+// copia una cadena literal sin medirla en tiempo de ejecución
+#define PUT_LIT( p, s ) ( memcpy( ( p ), ( s ), sizeof( s ) - 1 ), ( p ) + sizeof( s ) - 1 )
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// memoria de salida de un hilo; crece al doble cuando no alcanza
+typedef struct
+{
+   char* data;
+   size_t len;
+   size_t cap;
+   bool failed; ///< no hubo memoria; el contenido está incompleto
+} Buffer;
+
+typedef struct Report Report;
+
+typedef struct
+{
+   Report* report;
+   int id;
+   Buffer out;
+} ReportWorker;
+
+struct Report
+{
+   const Graph* g;
+   eReportFormat format;
+   int first_live; ///< primer vértice no borrado; en JSON es el único sin coma antes
+
+   int threads;
+   ReportWorker* workers;
+   pthread_t* tids;
+   pthread_mutex_t launch; ///< los hilos esperan aquí a que se sepa cuántos se crearon
+   pthread_barrier_t start;
+   pthread_barrier_t done;
+
+   int base;       ///< primer vértice de la ronda; el hilo i toma el bloque i
+   bool quit;
+};
+
+// asegura que quepan |n| bytes más
+static bool reserve( Buffer* b, size_t n )
+{
+   if( b->len + n <= b->cap ) return true;
+
+   size_t cap = b->cap > 0 ? b->cap : 1 << 16;
+   while( cap < b->len + n ) cap *= 2;
+
+   char* data = (char*) realloc( b->data, cap );
+   if( !data )
+   {
+      b->failed = true;
+      return false;
+   }
+
+   b->data = data;
+   b->cap = cap;
+   return true;
+}
+
+static char* put_str( char* p, const char* s )
+{
+   size_t len = strlen( s );
+   memcpy( p, s, len );
+   return p + len;
+}
+
+static char* put_uint( char* p, unsigned long v )
+{
+   char tmp[ 24 ];
+   int n = 0;
+   do
+   {
+      tmp[ n++ ] = (char)( '0' + v % 10 );
+      v /= 10;
+   } while( v );
+
+   while( n ) *p++ = tmp[ --n ];
+   return p;
+}
+
+static char* put_int( char* p, long v )
+{
+   if( v < 0 )
+   {
+      *p++ = '-';
+      return put_uint( p, 0ul - (unsigned long) v );
+   }
+   return put_uint( p, (unsigned long) v );
+}
+
+// |x| con |decimals| decimales (a lo más 6), redondeado al más cercano, como
+// "%.*f". Los valores enormes (o NAN) se escriben con "%.17g", que es corto
+static char* put_fixed( char* p, double x, int decimals )
+{
+   static const double scale[] = { 1, 10, 100, 1e3, 1e4, 1e5, 1e6 };
+   assert( 0 <= decimals && decimals <= 6 );
+
+   double ax = fabs( x );
+   if( !( ax < 1e12 ) ) return p + sprintf( p, "%.17g", x );
+
+   if( signbit( x ) ) *p++ = '-';
+
+   unsigned long v = (unsigned long) llround( ax * scale[ decimals ] );
+   unsigned long den = (unsigned long) scale[ decimals ];
+
+   p = put_uint( p, v / den );
+   if( decimals > 0 )
+   {
+      *p++ = '.';
+      unsigned long frac = v % den;
+      for( int d = decimals - 1; d >= 0; --d )
+      {
+         p[ d ] = (char)( '0' + frac % 10 );
+         frac /= 10;
+      }
+      p += decimals;
+   }
+   return p;
+}
+
+// cadena JSON entre comillas, escapando comillas, diagonales y caracteres de control
+static char* put_json_str( char* p, const char* s )
+{
+   static const char hex[] = "0123456789abcdef";
+
+   *p++ = '"';
+   for( ; *s; ++s )
+   {
+      unsigned char c = (unsigned char) *s;
+      if( c == '"' || c == '\\' )
+      {
+         *p++ = '\\';
+         *p++ = (char) c;
+      }
+      else if( c < 0x20 )
+      {
+         p = PUT_LIT( p, "\\u00" );
+         *p++ = hex[ c >> 4 ];
+         *p++ = hex[ c & 15 ];
+      }
+      else
+      {
+         *p++ = (char) c;
+      }
+   }
+   *p++ = '"';
+   return p;
+}
+
+// campo CSV (RFC 4180): entre comillas sólo si hace falta, duplicando las comillas
+static char* put_csv_str( char* p, const char* s )
+{
+   if( !s[ strcspn( s, ",\"\r\n" ) ] ) return put_str( p, s );
+
+   *p++ = '"';
+   for( ; *s; ++s )
+   {
+      if( *s == '"' ) *p++ = '"';
+      *p++ = *s;
+   }
+   *p++ = '"';
+   return p;
+}
+
+static char* put_coordinate( char* p, float x, eReportFormat format )
+{
+   if( isnan( x ) ) return format == eReportFormat_JSON ? PUT_LIT( p, "null" ) : p;
+   return put_fixed( p, x, 6 );
+}
+
+// los datos del aeropuerto como las columnas de un renglón CSV (con la coma final)
+static char* put_csv_vertex( char* p, const Graph* g, int v )
+{
+   p = put_int( p, v );                         *p++ = ',';
+   p = put_int( p, g->ids[ v ] );               *p++ = ',';
+   p = put_csv_str( p, Graph_GetIata( g, v ) ); *p++ = ',';
+   p = put_csv_str( p, Graph_GetName( g, v ) ); *p++ = ',';
+   p = put_csv_str( p, Graph_GetCity( g, v ) ); *p++ = ',';
+   p = put_csv_str( p, Graph_GetCountry( g, v ) ); *p++ = ',';
+   p = put_int( p, g->utc_times[ v ] );         *p++ = ',';
+   p = put_coordinate( p, g->latitudes[ v ], eReportFormat_CSV );  *p++ = ',';
+   p = put_coordinate( p, g->longitudes[ v ], eReportFormat_CSV ); *p++ = ',';
+   return p;
+}
+
+// el renglón de Graph_Print() para el vértice |v| (pre: hay espacio)
+static char* format_text( char* p, const Graph* g, int v )
+{
+   const Vertex* vertex = &g->vertices[ v ];
+   bool directed = g->type == eGraphType_DIRECTED;
+
+   if( directed && !vertex->neighbors ) return PUT_LIT( p, "\n" );
+
+   *p++ = '[';
+   p = put_int( p, v );
+   p = directed ? PUT_LIT( p, "]Los aviones en el aeropuerto con id " ) : PUT_LIT( p, "]El aeropuerto con id " );
+   p = put_int( p, g->ids[ v ] );
+   p = PUT_LIT( p, " con tiempo UTC= " );
+   p = put_int( p, g->utc_times[ v ] );
+   p = PUT_LIT( p, " con código IATA " );
+   p = put_str( p, Graph_GetIata( g, v ) );
+   p = PUT_LIT( p, " del país " );
+   p = put_str( p, Graph_GetCountry( g, v ) );
+   p = PUT_LIT( p, " de la ciudad " );
+   p = put_str( p, Graph_GetCity( g, v ) );
+   p = PUT_LIT( p, " con el nombre de " );
+   p = put_str( p, Graph_GetName( g, v ) );
+   *p++ = ' ';
+
+   if( vertex->neighbors )
+   {
+      p = directed ? PUT_LIT( p, "puede ir a " ) : PUT_LIT( p, "es vecino de " );
+
+      for( List_Iterator it = Vertex_Begin( vertex ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+      {
+         Edge e = List_Iterator_get( it );
+         if( Graph_IsRemoved( g, e.index ) ) continue;
+
+         p = PUT_LIT( p, "el aeropuerto con IATA " );
+         p = put_str( p, Graph_GetIata( g, e.index ) );
+         if( directed )
+         {
+            p = PUT_LIT( p, " con un tiempo de " );
+            p = put_fixed( p, e.weight, 2 );
+         }
+         p = PUT_LIT( p, ", " );
+      }
+   }
+
+   return directed ? PUT_LIT( p, "\n" ) : PUT_LIT( p, "y nada más.\n" );
+}
+
+static char* format_csv( char* p, const Graph* g, int v )
+{
+   const Vertex* vertex = &g->vertices[ v ];
+   bool any = false;
+
+   for( List_Iterator it = Vertex_Begin( vertex ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+   {
+      Edge e = List_Iterator_get( it );
+      if( Graph_IsRemoved( g, e.index ) ) continue;
+
+      p = put_csv_vertex( p, g, v );
+      p = put_int( p, e.index );                          *p++ = ',';
+      p = put_int( p, g->ids[ e.index ] );                *p++ = ',';
+      p = put_csv_str( p, Graph_GetIata( g, e.index ) );  *p++ = ',';
+      p = put_fixed( p, e.weight, 2 );
+      *p++ = '\n';
+      any = true;
+   }
+
+   if( !any )
+   {
+      // un aeropuerto sin rutas también aparece, con las columnas de destino vacías
+      p = put_csv_vertex( p, g, v );
+      p = PUT_LIT( p, ",,,\n" );
+   }
+   return p;
+}
+
+static char* format_json( char* p, const Graph* g, int v, bool first )
+{
+   const Vertex* vertex = &g->vertices[ v ];
+
+   if( !first ) p = PUT_LIT( p, ",\n" );
+
+   p = PUT_LIT( p, "{\"index\":" );
+   p = put_int( p, v );
+   p = PUT_LIT( p, ",\"id\":" );
+   p = put_int( p, g->ids[ v ] );
+   p = PUT_LIT( p, ",\"iata\":" );
+   p = put_json_str( p, Graph_GetIata( g, v ) );
+   p = PUT_LIT( p, ",\"name\":" );
+   p = put_json_str( p, Graph_GetName( g, v ) );
+   p = PUT_LIT( p, ",\"city\":" );
+   p = put_json_str( p, Graph_GetCity( g, v ) );
+   p = PUT_LIT( p, ",\"country\":" );
+   p = put_json_str( p, Graph_GetCountry( g, v ) );
+   p = PUT_LIT( p, ",\"utc\":" );
+   p = put_int( p, g->utc_times[ v ] );
+   p = PUT_LIT( p, ",\"latitude\":" );
+   p = put_coordinate( p, g->latitudes[ v ], eReportFormat_JSON );
+   p = PUT_LIT( p, ",\"longitude\":" );
+   p = put_coordinate( p, g->longitudes[ v ], eReportFormat_JSON );
+   p = PUT_LIT( p, ",\"routes\":[" );
+
+   bool any = false;
+   for( List_Iterator it = Vertex_Begin( vertex ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+   {
+      Edge e = List_Iterator_get( it );
+      if( Graph_IsRemoved( g, e.index ) ) continue;
+
+      if( any ) *p++ = ',';
+      p = PUT_LIT( p, "{\"index\":" );
+      p = put_int( p, e.index );
+      p = PUT_LIT( p, ",\"id\":" );
+      p = put_int( p, g->ids[ e.index ] );
+      p = PUT_LIT( p, ",\"iata\":" );
+      p = put_json_str( p, Graph_GetIata( g, e.index ) );
+      p = PUT_LIT( p, ",\"hours\":" );
+      p = put_fixed( p, e.weight, 2 );
+      *p++ = '}';
+      any = true;
+   }
+
+   return PUT_LIT( p, "]}" );
+}
+
+// formatea los vértices [begin, end) al final de |b|
+static void format_range( const Report* r, Buffer* b, int begin, int end )
+{
+   const Graph* g = r->g;
+   size_t route_bound = r->format == eReportFormat_CSV ? CSV_ROUTE_BOUND : ROUTE_BOUND;
+
+   for( int v = begin; v < end; ++v )
+   {
+      if( g->vertices[ v ].removed ) continue;
+
+      if( !reserve( b, VERTEX_BOUND + (size_t) g->vertices[ v ].degree * route_bound ) ) return;
+
+      char* p = b->data + b->len;
+      switch( r->format )
+      {
+         case eReportFormat_TEXT: p = format_text( p, g, v ); break;
+         case eReportFormat_CSV:  p = format_csv( p, g, v ); break;
+         case eReportFormat_JSON: p = format_json( p, g, v, v == r->first_live ); break;
+      }
+      b->len = p - b->data;
+   }
+}
+
+// el hilo |w| formatea su bloque de la ronda actual
+static void do_chunk( Report* r, ReportWorker* w )
+{
+   w->out.len = 0;
+
+   int begin = r->base + w->id * REPORT_CHUNK;
+   int end = begin + REPORT_CHUNK;
+   if( begin > r->g->len ) begin = r->g->len;
+   if( end > r->g->len ) end = r->g->len;
+
+   format_range( r, &w->out, begin, end );
+}
+
+static void* worker_main( void* arg )
+{
+   ReportWorker* w = (ReportWorker*) arg;
+   Report* r = w->report;
+
+   pthread_mutex_lock( &r->launch );
+   pthread_mutex_unlock( &r->launch );
+
+   for( ;; )
+   {
+      pthread_barrier_wait( &r->start );
+      if( r->quit ) break;
+
+      do_chunk( r, w );
+
+      pthread_barrier_wait( &r->done );
+   }
+   return NULL;
+}
+
+// escribe |len| bytes; ret: false si hubo un error de escritura
+static bool flush( FILE* out, const char* data, size_t len )
+{
+   return len == 0 || fwrite( data, 1, len, out ) == len;
+}
+
+static const char* header( eReportFormat format, eGraphType type )
+{
+   switch( format )
+   {
+      case eReportFormat_CSV:
+         return "index,id,iata,name,city,country,utc,latitude,longitude,dest_index,dest_id,dest_iata,hours\n";
+      case eReportFormat_JSON:
+         return type == eGraphType_DIRECTED ? "{\"type\":\"directed\",\"airports\":[\n" : "{\"type\":\"undirected\",\"airports\":[\n";
+      default:
+         return "";
+   }
+}
+
+static const char* trailer( eReportFormat format )
+{
+   switch( format )
+   {
+      case eReportFormat_TEXT: return "\n";
+      case eReportFormat_JSON: return "\n]}\n";
+      default:                 return "";
+   }
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Escribe un reporte completo del grafo.
+ *
+ * Cada hilo formatea bloques de REPORT_CHUNK vértices en su propia memoria, sin
+ * stdio y sin copiar registros: los números se convierten a mano y los vecinos
+ * se recorren con iteradores. En cada ronda los hilos toman bloques
+ * consecutivos y, al terminar, el hilo que llama los escribe en orden con una
+ * llamada a fwrite() por bloque, así que el resultado es el mismo con
+ * cualquier número de hilos. Los vértices borrados y las aristas que llegan a
+ * ellos no aparecen.
+ *
+ * Los números con decimales se escriben redondeados al más cercano: los pesos
+ * con 2 decimales y las coordenadas con 6.
+ *
+ * @param g       El grafo. No debe modificarse mientras se escribe el reporte.
+ * @param format  El formato del reporte.
+ * @param out     Archivo de salida.
+ * @param threads Número de hilos, incluyendo al que llama. Si no se pueden
+ *                crear todos, se trabaja con los que sí se crearon.
+ *
+ * @return Los bytes escritos; -1 si no hubo memoria o falló la escritura.
+ */
+long Report_Write( const Graph* g, eReportFormat format, FILE* out, int threads )
+{
+   assert( threads > 0 );
+
+   Report r;
+   memset( &r, 0, sizeof( Report ) );
+   r.g = g;
+   r.format = format;
+   r.threads = threads;
+
+   r.first_live = 0;
+   while( r.first_live < g->len && g->vertices[ r.first_live ].removed ) ++r.first_live;
+
+   r.workers = (ReportWorker*) calloc( threads, sizeof( ReportWorker ) );
+   r.tids = (pthread_t*) calloc( threads, sizeof( pthread_t ) );
+   if( !r.workers || !r.tids )
+   {
+      free( r.workers );
+      free( r.tids );
+      return -1;
+   }
+
+   for( int i = 0; i < threads; ++i )
+   {
+      r.workers[ i ].report = &r;
+      r.workers[ i ].id = i;
+   }
+   pthread_mutex_init( &r.launch, NULL );
+
+   if( threads > 1 )
+   {
+      // si no se crean todos los hilos, el reporte se reparte entre los que sí;
+      // las barreras se inicializan con ese número antes de que los hilos las usen
+      pthread_mutex_lock( &r.launch );
+
+      int started = 1;
+      while( started < threads && pthread_create( &r.tids[ started ], NULL, worker_main, &r.workers[ started ] ) == 0 ) ++started;
+
+      threads = r.threads = started;
+      if( threads > 1 )
+      {
+         pthread_barrier_init( &r.start, NULL, threads );
+         pthread_barrier_init( &r.done, NULL, threads );
+      }
+      pthread_mutex_unlock( &r.launch );
+   }
+
+   const char* head = header( format, g->type );
+   long written = (long) strlen( head );
+   bool ok = flush( out, head, written );
+
+   for( r.base = 0; ok && r.base < g->len; r.base += threads * REPORT_CHUNK )
+   {
+      if( threads > 1 ) pthread_barrier_wait( &r.start );
+      do_chunk( &r, &r.workers[ 0 ] );
+      if( threads > 1 ) pthread_barrier_wait( &r.done );
+
+      for( int i = 0; ok && i < threads; ++i )
+      {
+         Buffer* b = &r.workers[ i ].out;
+         ok = !b->failed && flush( out, b->data, b->len );
+         written += (long) b->len;
+      }
+   }
+
+   if( ok )
+   {
+      const char* tail = trailer( format );
+      ok = flush( out, tail, strlen( tail ) );
+      written += (long) strlen( tail );
+   }
+
+   if( threads > 1 )
+   {
+      r.quit = true;
+      pthread_barrier_wait( &r.start );
+      for( int i = 1; i < threads; ++i ) pthread_join( r.tids[ i ], NULL );
+
+      pthread_barrier_destroy( &r.start );
+      pthread_barrier_destroy( &r.done );
+   }
+
+   pthread_mutex_destroy( &r.launch );
+
+   for( int i = 0; i < threads; ++i ) free( r.workers[ i ].out.data );
+   free( r.workers );
+   free( r.tids );
+
+   return ok ? written : -1;
+}
@@ -0,0 +1,29 @@
+#ifndef  REPORT_INC
+#define  REPORT_INC
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "Graph.h"
+
+/**
+ * @brief Formato del reporte.
+ */
+typedef enum
+{
+   eReportFormat_TEXT, ///< texto para personas (el de Graph_Print())
+   eReportFormat_CSV,  ///< un renglón por ruta (o por aeropuerto sin rutas), con encabezado
+   eReportFormat_JSON  ///< un objeto por aeropuerto con el arreglo de sus rutas
+} eReportFormat;
+
+/**
+ * @brief Número de vértices que un hilo formatea de una vez. Con |threads| hilos
+ * el reporte ocupa en memoria a lo más |threads| bloques de este tamaño.
+ */
+#ifndef REPORT_CHUNK
+#define REPORT_CHUNK 4096
+#endif
+
+long Report_Write( const Graph* g, eReportFormat format, FILE* out, int threads );
+
+#endif   /* ----- #ifndef REPORT_INC  ----- */
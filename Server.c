@@ -0,0 +1,444 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <unistd.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Server.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// respuesta en construcción sobre un arreglo de tamaño fijo
+typedef struct
+{
+   char* buf;
+   size_t cap;
+   size_t len;
+   bool full;
+} Reply;
+
+// agrega texto con formato a la respuesta; si ya no cabe la trunca con "..."
+static void reply_printf( Reply* r, const char* fmt, ... )
+{
+   if( r->full ) return;
+
+   va_list args;
+   va_start( args, fmt );
+   int n = vsnprintf( r->buf + r->len, r->cap - r->len, fmt, args );
+   va_end( args );
+
+   if( n < 0 || (size_t) n >= r->cap - r->len - 4 )
+   {
+      // dejamos lugar para "...\n"
+      r->len = r->cap > 5 ? r->cap - 5 : 0;
+      memcpy( r->buf + r->len, "...", 3 );
+      r->len += 3;
+      r->buf[ r->len ] = '\0';
+      r->full = true;
+   }
+   else r->len += n;
+}
+
+// lee de |*p| el siguiente token, que debería ser un código IATA
+// ret: false si no hay más tokens
+static bool next_code( const char** p, char code[ 4 ] )
+{
+   const char* s = *p;
+   while( *s == ' ' || *s == '\t' ) ++s;
+
+   int n = 0;
+   while( *s && *s != ' ' && *s != '\t' && *s != '\r' )
+   {
+      if( n < 3 ) code[ n ] = *s;
+      ++n;
+      ++s;
+   }
+   *p = s;
+
+   code[ n <= 3 ? n : 0 ] = '\0';
+   // un token de más de 3 caracteres no puede ser un código IATA
+
+   return n > 0;
+}
+
+// contesta las consultas del lote actual hasta que ya no queden
+static void process_batch( Server* srv, ServerWorker* w )
+{
+   int i;
+   while( ( i = atomic_fetch_add( &srv->next, 1 ) ) < srv->count )
+   {
+      Server_Answer( srv, w, srv->lines[ i ], srv->out[ i ], SERVER_LINE_MAX );
+   }
+}
+
+// libera la memoria de trabajo de los primeros |n| hilos y al servidor
+static void free_server( Server* srv, int n )
+{
+   for( int i = 0; i < n; ++i )
+   {
+      PathScratch_Free( &srv->workers[ i ].scratch );
+      Cache_Delete( &srv->workers[ i ].cache );
+      free( srv->workers[ i ].path );
+   }
+   free( srv->workers );
+   free( srv->tids );
+   free( srv );
+}
+
+static void* worker_main( void* arg )
+{
+   ServerWorker* w = (ServerWorker*) arg;
+   Server* srv = w->srv;
+
+   pthread_mutex_lock( &srv->launch );
+   pthread_mutex_unlock( &srv->launch );
+   if( srv->quit ) return NULL;
+   // no se pudieron crear todos los hilos; las barreras nunca se llenarían
+
+   for( ;; )
+   {
+      pthread_barrier_wait( &srv->start );
+      if( srv->quit ) break;
+
+      process_batch( srv, w );
+
+      pthread_barrier_wait( &srv->done );
+   }
+   return NULL;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Crea un servidor de consultas con |threads| hilos.
+ *
+ * @param csr     La copia congelada del grafo (de Graph_Freeze() o Snapshot_Load()).
+ * @param threads Número de hilos, incluyendo al que llama a Server_AnswerBatch().
+ *
+ * @return El servidor; NULL si no hubo recursos.
+ */
+Server* Server_New( const CSR* csr, int threads )
+{
+   assert( threads > 0 );
+
+   Server* srv = (Server*) calloc( 1, sizeof( Server ) );
+   if( !srv ) return NULL;
+
+   srv->csr = csr;
+   srv->threads = threads;
+   srv->workers = (ServerWorker*) calloc( threads, sizeof( ServerWorker ) );
+   srv->tids = (pthread_t*) calloc( threads, sizeof( pthread_t ) );
+   if( !srv->workers || !srv->tids )
+   {
+      free( srv->workers );
+      free( srv->tids );
+      free( srv );
+      return NULL;
+   }
+
+   int len = csr->len > 0 ? csr->len : 1;
+   for( int i = 0; i < threads; ++i )
+   {
+      ServerWorker* w = &srv->workers[ i ];
+      w->srv = srv;
+      w->path = (int*) malloc( len * sizeof( int ) );
+      w->cache = Cache_New( SERVER_CACHE_ENTRIES );
+
+      if( !w->path || !w->cache || !PathScratch_Init( &w->scratch, len ) )
+      {
+         // no hay memoria para todos; los hilos ya preparados se liberan abajo
+         free( w->path );
+         if( w->cache ) Cache_Delete( &w->cache );
+         srv->threads = i;
+         threads = 0;
+         break;
+      }
+   }
+
+   if( threads == 0 )
+   {
+      free_server( srv, srv->threads );
+      return NULL;
+   }
+
+   pthread_barrier_init( &srv->start, NULL, threads );
+   pthread_barrier_init( &srv->done, NULL, threads );
+   atomic_init( &srv->next, 0 );
+
+   // los hilos no tocan las barreras hasta que se sabe que se crearon todos
+   pthread_mutex_init( &srv->launch, NULL );
+   pthread_mutex_lock( &srv->launch );
+
+   int started = 1;
+   while( started < threads && pthread_create( &srv->tids[ started ], NULL, worker_main, &srv->workers[ started ] ) == 0 ) ++started;
+
+   srv->quit = started < threads;
+   pthread_mutex_unlock( &srv->launch );
+
+   if( srv->quit )
+   {
+      for( int i = 1; i < started; ++i ) pthread_join( srv->tids[ i ], NULL );
+
+      pthread_barrier_destroy( &srv->start );
+      pthread_barrier_destroy( &srv->done );
+      pthread_mutex_destroy( &srv->launch );
+      free_server( srv, threads );
+      return NULL;
+   }
+
+   return srv;
+}
+
+/**
+ * @brief Detiene los hilos y libera al servidor.
+ */
+void Server_Delete( Server** p_srv )
+{
+   assert( *p_srv );
+
+   Server* srv = *p_srv;
+
+   srv->quit = true;
+   pthread_barrier_wait( &srv->start );
+   for( int i = 1; i < srv->threads; ++i ) pthread_join( srv->tids[ i ], NULL );
+
+   pthread_barrier_destroy( &srv->start );
+   pthread_barrier_destroy( &srv->done );
+   pthread_mutex_destroy( &srv->launch );
+
+   free_server( srv, srv->threads );
+   *p_srv = NULL;
+}
+
+/**
+ * @brief Contesta una consulta usando la memoria de trabajo |w|.
+ *
+ * @param srv  El servidor.
+ * @param w    La memoria de trabajo del hilo que contesta.
+ * @param line La consulta (ver Server).
+ * @param out  Donde se escribe la respuesta, terminada en '\n'.
+ * @param cap  Tamaño de |out|.
+ *
+ * @return El número de caracteres escritos en |out|.
+ */
+int Server_Answer( const Server* srv, ServerWorker* w, const char* line, char* out, size_t cap )
+{
+   assert( cap > 8 );
+
+   Reply r = { out, cap - 1, 0, false };
+   // cap - 1: siempre queda lugar para el '\n'
+
+   const CSR* csr = srv->csr;
+
+   while( *line == ' ' || *line == '\t' ) ++line;
+   char kind = *line ? *line++ : '\0';
+
+   char from[ 4 ], to[ 4 ];
+   bool has_from = next_code( &line, from );
+   bool has_to = next_code( &line, to );
+
+   int src = has_from ? CSR_GetIndexByIata( csr, from ) : -1;
+   int dst = has_to ? CSR_GetIndexByIata( csr, to ) : -1;
+
+   // las consultas válidas se buscan primero en el caché del hilo
+   bool cacheable = ( kind == 'N' && src != -1 ) || ( ( kind == 'R' || kind == 'P' ) && src != -1 && dst != -1 );
+   if( cacheable )
+   {
+      size_t len;
+      const char* hit = Cache_Get( w->cache, kind, src, kind == 'N' ? -1 : dst, csr->version, &len );
+      if( hit && len < cap )
+      {
+         memcpy( out, hit, len );
+         out[ len ] = '\0';
+         return (int) len;
+      }
+   }
+
+   switch( kind )
+   {
+      case 'N':
+         if( src == -1 )
+         {
+            reply_printf( &r, "ERR unknown airport" );
+            break;
+         }
+
+         reply_printf( &r, "%s:", from );
+         for( int k = csr->offsets[ src ]; k < csr->offsets[ src + 1 ]; ++k )
+         {
+            reply_printf( &r, " %s %.2f", csr->data[ csr->targets[ k ] ].iata_code, csr->weights[ k ] );
+         }
+         break;
+
+      case 'R':
+      case 'P':
+         if( src == -1 || dst == -1 )
+         {
+            reply_printf( &r, "ERR unknown airport" );
+            break;
+         }
+
+         int path_len;
+         float hours = Path_Dijkstra( csr, src, dst, &w->scratch, w->path, csr->len, &path_len );
+
+         if( kind == 'R' )
+         {
+            reply_printf( &r, hours != INFINITY ? "yes" : "no" );
+         }
+         else if( hours == INFINITY )
+         {
+            reply_printf( &r, "none" );
+         }
+         else
+         {
+            reply_printf( &r, "%.2f", hours );
+            for( int i = 0; i < path_len; ++i )
+            {
+               reply_printf( &r, " %s", csr->data[ w->path[ i ] ].iata_code );
+            }
+         }
+         break;
+
+      default:
+         reply_printf( &r, "ERR unknown query" );
+         break;
+   }
+
+   out[ r.len++ ] = '\n';
+   out[ r.len ] = '\0';
+
+   if( cacheable ) Cache_Put( w->cache, kind, src, kind == 'N' ? -1 : dst, csr->version, out, r.len );
+
+   return (int) r.len;
+}
+
+/**
+ * @brief Contesta un lote de consultas repartiéndolas entre los hilos del servidor.
+ *
+ * @param srv   El servidor.
+ * @param lines Las consultas.
+ * @param count Número de consultas.
+ * @param out   out[ i ] recibe la respuesta de lines[ i ].
+ */
+void Server_AnswerBatch( Server* srv, const char* const lines[], int count, char out[][ SERVER_LINE_MAX ] )
+{
+   srv->lines = lines;
+   srv->count = count;
+   srv->out = out;
+   atomic_store( &srv->next, 0 );
+
+   pthread_barrier_wait( &srv->start );
+   process_batch( srv, &srv->workers[ 0 ] );
+   pthread_barrier_wait( &srv->done );
+}
+
+/**
+ * @brief Lee consultas del descriptor |in_fd| hasta el fin de archivo y escribe
+ * las respuestas, en orden, en |out|.
+ *
+ * Las consultas que llegan juntas se contestan como un lote, de manera que una
+ * entrada interactiva recibe respuesta inmediata y una entrada masiva (p.ej. un
+ * archivo o un generador de carga) aprovecha a todos los hilos.
+ *
+ * @return false si hubo un error de lectura o de memoria.
+ */
+bool Server_Run( Server* srv, int in_fd, FILE* out )
+{
+   size_t cap = 1 << 16;
+   char* buf = (char*) malloc( cap );
+   char ( *replies )[ SERVER_LINE_MAX ] = malloc( SERVER_BATCH_MAX * sizeof( *replies ) );
+   const char** lines = (const char**) malloc( SERVER_BATCH_MAX * sizeof( char* ) );
+
+   if( !buf || !replies || !lines )
+   {
+      free( buf );
+      free( replies );
+      free( lines );
+      return false;
+   }
+
+   size_t len = 0;
+   bool ok = true;
+   bool eof = false;
+
+   while( !eof )
+   {
+      ssize_t n = read( in_fd, buf + len, cap - 1 - len );
+      if( n < 0 )
+      {
+         ok = false;
+         break;
+      }
+      if( n == 0 ) eof = true;
+      len += n;
+
+      // una línea más larga que el búfer se contesta tal cual (con error)
+      if( !eof && len == cap - 1 && !memchr( buf, '\n', len ) ) buf[ len - 1 ] = '\n';
+
+      size_t begin = 0;
+      int count = 0;
+      for( size_t i = 0; i < len; ++i )
+      {
+         bool last = eof && i == len - 1 && buf[ i ] != '\n';
+         if( buf[ i ] != '\n' && !last ) continue;
+
+         if( last ) buf[ len ] = '\0';
+         else buf[ i ] = '\0';
+
+         if( buf[ begin ] != '\0' ) lines[ count++ ] = buf + begin;
+         begin = i + 1;
+
+         if( count == SERVER_BATCH_MAX )
+         {
+            Server_AnswerBatch( srv, lines, count, replies );
+            for( int q = 0; q < count; ++q ) fputs( replies[ q ], out );
+            count = 0;
+         }
+      }
+
+      if( count > 0 )
+      {
+         Server_AnswerBatch( srv, lines, count, replies );
+         for( int q = 0; q < count; ++q ) fputs( replies[ q ], out );
+      }
+      fflush( out );
+
+      // la línea incompleta se queda para la siguiente lectura
+      if( begin < len ) memmove( buf, buf + begin, len - begin );
+      len = begin < len ? len - begin : 0;
+   }
+
+   free( buf );
+   free( replies );
+   free( lines );
+   return ok;
+}
+
+/**
+ * @brief Suma los contadores de los cachés de todos los hilos.
+ *
+ * @pre No hay un lote en curso (los hilos escriben sus contadores sin candados).
+ */
+CacheStats Server_GetCacheStats( const Server* srv )
+{
+   CacheStats total = { 0 };
+   for( int i = 0; i < srv->threads; ++i )
+   {
+      CacheStats s = Cache_GetStats( srv->workers[ i ].cache );
+      total.hits += s.hits;
+      total.misses += s.misses;
+      total.stale += s.stale;
+      total.evictions += s.evictions;
+      total.entries += s.entries;
+      total.bytes += s.bytes;
+   }
+   return total;
+}
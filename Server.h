@@ -0,0 +1,88 @@
+#ifndef  SERVER_INC
+#define  SERVER_INC
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "CSR.h"
+#include "Path.h"
+#include "Cache.h"
+
+/**
+ * @brief Tamaño máximo de una respuesta, incluyendo el fin de línea. Las
+ * respuestas más largas se truncan y terminan en "...".
+ */
+#define SERVER_LINE_MAX 4096
+
+/**
+ * @brief Número máximo de consultas que se contestan en un mismo lote.
+ */
+#define SERVER_BATCH_MAX 1024
+
+/**
+ * @brief Número de respuestas que guarda el caché de cada hilo.
+ */
+#ifndef SERVER_CACHE_ENTRIES
+#define SERVER_CACHE_ENTRIES 4096
+#endif
+
+typedef struct Server Server;
+
+/**
+ * @brief Memoria de trabajo de un hilo del servidor. Cada hilo tiene la suya,
+ * así que las consultas no reservan memoria ni comparten nada que se escriba.
+ */
+typedef struct
+{
+   Server* srv;
+   PathScratch scratch;
+   int* path;    ///< csr->len entradas
+   Cache* cache; ///< respuestas recientes, invalidadas por CSR::version
+} ServerWorker;
+
+/**
+ * @brief Servidor de consultas sobre un grafo que ya no cambia.
+ *
+ * Protocolo (una consulta por línea, códigos IATA):
+ *    N MEX        vecinos directos:       "MEX: CDG 9.00 FRA 10.00"
+ *    R MEX HKG    alcanzabilidad:         "yes" o "no"
+ *    P MEX HKG    itinerario más rápido:  "23.00 MEX CDG HKG" o "none"
+ * Las consultas mal formadas se contestan con una línea que empieza con "ERR".
+ * Las respuestas salen en el mismo orden que las consultas.
+ *
+ * La copia CSR del grafo sólo se lee, así que los hilos no usan candados en
+ * el camino de lectura; sólo se sincronizan al inicio y al final de cada lote.
+ * Cada hilo guarda sus respuestas recientes en su propio caché; si la copia
+ * cambia entre lotes (CSR_SetEdgeWeight()) las respuestas guardadas dejan de valer.
+ */
+struct Server
+{
+   const CSR* csr;
+
+   int threads;           ///< número de hilos, incluyendo al que llama
+   ServerWorker* workers; ///< |threads| entradas
+   pthread_t* tids;       ///< |threads| - 1 entradas
+
+   pthread_mutex_t launch;  ///< los hilos esperan aquí a que Server_New() termine de crearlos
+   pthread_barrier_t start; ///< los hilos esperan aquí un lote nuevo
+   pthread_barrier_t done;  ///< y aquí a que el lote se termine
+
+   const char* const* lines;       ///< el lote actual
+   int count;
+   char ( *out )[ SERVER_LINE_MAX ];
+   atomic_int next;                ///< siguiente consulta del lote sin contestar
+   bool quit;
+};
+
+Server* Server_New( const CSR* csr, int threads );
+void Server_Delete( Server** p_srv );
+
+int Server_Answer( const Server* srv, ServerWorker* w, const char* line, char* out, size_t cap );
+void Server_AnswerBatch( Server* srv, const char* const lines[], int count, char out[][ SERVER_LINE_MAX ] );
+bool Server_Run( Server* srv, int in_fd, FILE* out );
+CacheStats Server_GetCacheStats( const Server* srv );
+
+#endif   /* ----- #ifndef SERVER_INC  ----- */
@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Snapshot.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+#define SECTION_ALIGN 64
+#define NUM_SECTIONS 10
+
+static const char magic[ 8 ] = { 'A', 'I', 'R', 'G', 'R', 'A', 'P', 'H' };
+
+// tamaño en bytes de cada sección, en el orden en que aparecen en el archivo
+static void section_sizes( uint64_t len, uint64_t edges, uint64_t sizes[ NUM_SECTIONS ] )
+{
+   sizes[ 0 ] = len * sizeof( Data );
+   sizes[ 1 ] = ( len + 1 ) * sizeof( int );
+   sizes[ 2 ] = edges * sizeof( int );
+   sizes[ 3 ] = edges * sizeof( float );
+   sizes[ 4 ] = ( len + 1 ) * sizeof( int );
+   sizes[ 5 ] = edges * sizeof( int );
+   sizes[ 6 ] = edges * sizeof( float );
+   sizes[ 7 ] = len * sizeof( float );
+   sizes[ 8 ] = len * sizeof( float );
+   sizes[ 9 ] = IATA_INDEX_SIZE * sizeof( int );
+}
+
+static uint64_t align_up( uint64_t n )
+{
+   return ( n + SECTION_ALIGN - 1 ) & ~(uint64_t)( SECTION_ALIGN - 1 );
+}
+
+// suma de verificación de 64 bits (multiplicativa, 8 bytes por paso); no es
+// criptográfica, sólo detecta archivos truncados o corrompidos
+static uint64_t checksum_update( uint64_t h, const void* buf, size_t n )
+{
+   const unsigned char* p = (const unsigned char*) buf;
+
+   while( n >= 8 )
+   {
+      uint64_t w;
+      memcpy( &w, p, 8 );
+      h = ( h ^ w ) * 0x100000001b3ULL;
+      h ^= h >> 29;
+      p += 8;
+      n -= 8;
+   }
+   while( n-- > 0 )
+   {
+      h = ( h ^ *p++ ) * 0x100000001b3ULL;
+   }
+   return h;
+}
+
+#define CHECKSUM_SEED 0xcbf29ce484222325ULL
+
+// escribe |n| bytes y, si hace falta, ceros hasta la siguiente alineación. El
+// último bloque incompleto se copia junto con su relleno para que la suma se
+// calcule sobre los mismos bloques de 8 bytes que ve Snapshot_Load()
+static bool write_section( FILE* f, const void* buf, uint64_t n, uint64_t* h )
+{
+   uint64_t head = n / SECTION_ALIGN * SECTION_ALIGN;
+   if( head > 0 && fwrite( buf, 1, head, f ) != head ) return false;
+   *h = checksum_update( *h, buf, head );
+
+   if( head < n )
+   {
+      char tail[ SECTION_ALIGN ] = { 0 };
+      memcpy( tail, (const char*) buf + head, n - head );
+      if( fwrite( tail, 1, SECTION_ALIGN, f ) != SECTION_ALIGN ) return false;
+      *h = checksum_update( *h, tail, SECTION_ALIGN );
+   }
+
+   return true;
+}
+
+// ret: true si |offsets| (len + 1 entradas) empieza en 0, no decrece y termina
+// en |edges|, y todos los índices de |targets| están en [0, len)
+static bool valid_adjacency( const int* offsets, const int* targets, int len, int edges )
+{
+   if( offsets[ 0 ] != 0 || offsets[ len ] != edges ) return false;
+
+   for( int v = 0; v < len; ++v )
+   {
+      if( offsets[ v ] > offsets[ v + 1 ] ) return false;
+   }
+   for( int e = 0; e < edges; ++e )
+   {
+      if( targets[ e ] < 0 || targets[ e ] >= len ) return false;
+   }
+   return true;
+}
+
+// revisa que los índices leídos del archivo no se salgan de los arreglos
+static bool valid_structure( const CSR* csr )
+{
+   for( int i = 0; i < IATA_INDEX_SIZE; ++i )
+   {
+      if( csr->iata_index[ i ] < -1 || csr->iata_index[ i ] >= csr->len ) return false;
+   }
+
+   return valid_adjacency( csr->offsets, csr->targets, csr->len, csr->edges ) &&
+          valid_adjacency( csr->rev_offsets, csr->rev_sources, csr->len, csr->edges );
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Guarda la copia CSR (vértices, adyacencia en ambos sentidos, pesos e
+ * índice IATA) en un archivo binario.
+ *
+ * Se escribe primero a un archivo temporal que luego se renombra, así que un
+ * lector nunca ve un archivo a medio escribir.
+ *
+ * @param csr  La copia congelada del grafo.
+ * @param path Nombre del archivo.
+ *
+ * @return false si hubo un error de escritura.
+ */
+bool Snapshot_Save( const CSR* csr, const char* path )
+{
+   char tmp[ 4096 ];
+   if( snprintf( tmp, sizeof( tmp ), "%s.tmp", path ) >= (int) sizeof( tmp ) ) return false;
+
+   FILE* f = fopen( tmp, "wb" );
+   if( !f ) return false;
+
+   const void* sections[ NUM_SECTIONS ] = {
+      csr->data, csr->offsets, csr->targets, csr->weights,
+      csr->rev_offsets, csr->rev_sources, csr->rev_weights,
+      csr->latitude, csr->longitude, csr->iata_index
+   };
+   uint64_t sizes[ NUM_SECTIONS ];
+   section_sizes( csr->len, csr->edges, sizes );
+
+   SnapshotHeader hdr;
+   memset( &hdr, 0, sizeof( hdr ) );
+   memcpy( hdr.magic, magic, sizeof( magic ) );
+   hdr.version = SNAPSHOT_VERSION;
+   hdr.byte_order = 0x01020304;
+   hdr.data_size = sizeof( Data );
+   hdr.iata_size = IATA_INDEX_SIZE;
+   hdr.len = csr->len;
+   hdr.edges = csr->edges;
+   hdr.flags = csr->sorted ? SNAPSHOT_SORTED : 0;
+   for( int i = 0; i < NUM_SECTIONS; ++i ) hdr.payload_size += align_up( sizes[ i ] );
+
+   // el encabezado se escribe dos veces: al final ya se conoce la suma de verificación
+   bool ok = fwrite( &hdr, sizeof( hdr ), 1, f ) == 1;
+
+   uint64_t h = CHECKSUM_SEED;
+   for( int i = 0; ok && i < NUM_SECTIONS; ++i ) ok = write_section( f, sections[ i ], sizes[ i ], &h );
+
+   hdr.checksum = h;
+   ok = ok && fseek( f, 0, SEEK_SET ) == 0 && fwrite( &hdr, sizeof( hdr ), 1, f ) == 1;
+   ok = ( fclose( f ) == 0 ) && ok;
+
+   if( ok ) ok = rename( tmp, path ) == 0;
+   if( !ok ) remove( tmp );
+
+   return ok;
+}
+
+/**
+ * @brief Abre un archivo creado con Snapshot_Save() y lo usa en su lugar.
+ *
+ * El archivo se proyecta en memoria y los arreglos de la copia CSR apuntan
+ * directamente a él: no se interpreta nada ni se reservan nodos, así que el
+ * tiempo de carga no depende del tamaño del grafo (las páginas se leen del
+ * disco conforme las consultas las tocan). La copia devuelta es de sólo lectura.
+ *
+ * @param path   Nombre del archivo.
+ * @param verify Si es true, además se recorre todo el archivo para comprobar la
+ *               suma de verificación y que los desplazamientos y los índices de
+ *               vértice estén dentro de los arreglos (esto sí es proporcional
+ *               al tamaño). Sin verificación el archivo se usa tal cual: sólo
+ *               para copias de confianza.
+ *
+ * @return La copia; NULL si el archivo no existe, no es de esta versión o
+ * arquitectura, está truncado o no pasa la verificación. Se libera con CSR_Delete().
+ */
+CSR* Snapshot_Load( const char* path, bool verify )
+{
+   int fd = open( path, O_RDONLY );
+   if( fd < 0 ) return NULL;
+
+   struct stat st;
+   if( fstat( fd, &st ) != 0 || (size_t) st.st_size < sizeof( SnapshotHeader ) )
+   {
+      close( fd );
+      return NULL;
+   }
+
+   size_t size = (size_t) st.st_size;
+   void* map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+   close( fd );
+   if( map == MAP_FAILED ) return NULL;
+
+   const SnapshotHeader* hdr = (const SnapshotHeader*) map;
+
+   uint64_t sizes[ NUM_SECTIONS ];
+   section_sizes( hdr->len, hdr->edges, sizes );
+
+   uint64_t payload = 0;
+   for( int i = 0; i < NUM_SECTIONS; ++i ) payload += align_up( sizes[ i ] );
+
+   bool ok = memcmp( hdr->magic, magic, sizeof( magic ) ) == 0 &&
+             hdr->version == SNAPSHOT_VERSION &&
+             hdr->byte_order == 0x01020304 &&
+             hdr->data_size == sizeof( Data ) &&
+             hdr->iata_size == IATA_INDEX_SIZE &&
+             hdr->len <= INT_MAX && hdr->edges <= INT_MAX &&
+             hdr->payload_size == payload &&
+             size >= sizeof( SnapshotHeader ) + payload;
+
+   if( ok && verify )
+   {
+      const char* body = (const char*) map + sizeof( SnapshotHeader );
+      ok = checksum_update( CHECKSUM_SEED, body, payload ) == hdr->checksum;
+   }
+
+   CSR* csr = ok ? (CSR*) calloc( 1, sizeof( CSR ) ) : NULL;
+   if( !csr )
+   {
+      munmap( map, size );
+      return NULL;
+   }
+
+   void* section[ NUM_SECTIONS ];
+   char* p = (char*) map + sizeof( SnapshotHeader );
+   for( int i = 0; i < NUM_SECTIONS; ++i )
+   {
+      section[ i ] = p;
+      p += align_up( sizes[ i ] );
+   }
+
+   csr->len = hdr->len;
+   csr->edges = hdr->edges;
+   csr->data = (Data*) section[ 0 ];
+   csr->offsets = (int*) section[ 1 ];
+   csr->targets = (int*) section[ 2 ];
+   csr->weights = (float*) section[ 3 ];
+   csr->rev_offsets = (int*) section[ 4 ];
+   csr->rev_sources = (int*) section[ 5 ];
+   csr->rev_weights = (float*) section[ 6 ];
+   csr->latitude = (float*) section[ 7 ];
+   csr->longitude = (float*) section[ 8 ];
+   csr->iata_index = (int*) section[ 9 ];
+   csr->sorted = ( hdr->flags & SNAPSHOT_SORTED ) != 0;
+   csr->map = map;
+   csr->map_size = size;
+
+   if( verify && !valid_structure( csr ) )
+   {
+      CSR_Delete( &csr );
+      return NULL;
+   }
+
+   return csr;
+}
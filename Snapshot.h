@@ -0,0 +1,48 @@
+#ifndef  SNAPSHOT_INC
+#define  SNAPSHOT_INC
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "CSR.h"
+
+/**
+ * @brief Versión del formato binario. Se incrementa cada vez que cambia la
+ * disposición del archivo o de |Data|.
+ */
+#define SNAPSHOT_VERSION 1
+
+/**
+ * @brief Bits de SnapshotHeader::flags.
+ */
+#define SNAPSHOT_SORTED 0x1 ///< los renglones de la copia estaban ordenados (ver CSR_Sort())
+
+/**
+ * @brief Encabezado del archivo binario.
+ *
+ * Después del encabezado vienen, en este orden y cada una alineada a 64 bytes,
+ * las secciones: data, offsets, targets, weights, rev_offsets, rev_sources,
+ * rev_weights, latitude, longitude e iata_index, con los mismos tamaños que en
+ * CSR. Los números se guardan en el orden de bytes de la máquina que escribe;
+ * |byte_order| permite detectar un archivo de otra arquitectura.
+ */
+typedef struct
+{
+   char magic[ 8 ];       ///< "AIRGRAPH"
+   uint32_t version;      ///< SNAPSHOT_VERSION
+   uint32_t byte_order;   ///< 0x01020304 escrito en el orden de la máquina
+   uint32_t data_size;    ///< sizeof( Data ) al escribir
+   uint32_t iata_size;    ///< IATA_INDEX_SIZE al escribir
+   uint32_t len;          ///< número de vértices
+   uint32_t edges;        ///< número de aristas
+   uint64_t payload_size; ///< bytes después del encabezado
+   uint64_t checksum;     ///< suma de verificación de los bytes después del encabezado
+   uint32_t flags;        ///< SNAPSHOT_SORTED; los archivos anteriores tienen 0 aquí
+   uint8_t reserved[ 12 ];
+} SnapshotHeader;
+
+bool Snapshot_Save( const CSR* csr, const char* path );
+CSR* Snapshot_Load( const char* path, bool verify );
+
+#endif   /* ----- #ifndef SNAPSHOT_INC  ----- */
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "StrPool.h"
+
+// capacidad inicial de la arena y de la tabla
+#define ARENA_MIN 1024
+#define TABLE_MIN_BITS 6
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// FNV-1a sobre los |len| bytes de |s|
+static uint32_t hash_str( const char* s, size_t len )
+{
+   uint32_t h = 2166136261u;
+   for( size_t i = 0; i < len; ++i )
+   {
+      h ^= (unsigned char) s[ i ];
+      h *= 16777619u;
+   }
+   return h;
+}
+
+// posición inicial de búsqueda en la tabla (Fibonacci hashing)
+static int slot_of( uint32_t h, int bits )
+{
+   return (int)( ( h * 2654435769u ) >> ( 32 - bits ) );
+}
+
+// ret: la posición de la cadena en la tabla, o la de la entrada libre donde
+// debería ir
+static int lookup( const StrPool* pool, const char* s, size_t len, uint32_t h )
+{
+   int mask = ( 1 << pool->bits ) - 1;
+   int i = slot_of( h, pool->bits );
+   while( pool->table[ i ] != 0 )
+   {
+      const char* c = pool->chars + pool->table[ i ];
+      if( strncmp( c, s, len ) == 0 && c[ len ] == '\0' ) return i;
+      i = ( i + 1 ) & mask;
+   }
+   return i;
+}
+
+// duplica la tabla y vuelve a insertar todas las referencias
+static bool grow_table( StrPool* pool )
+{
+   int bits = pool->bits + 1;
+   StrRef* table = (StrRef*) calloc( 1 << bits, sizeof( StrRef ) );
+   if( !table ) return false;
+
+   int mask = ( 1 << bits ) - 1;
+   for( int k = 0; k < ( 1 << pool->bits ); ++k )
+   {
+      StrRef ref = pool->table[ k ];
+      if( ref == 0 ) continue;
+
+      const char* c = pool->chars + ref;
+      int i = slot_of( hash_str( c, strlen( c ) ), bits );
+      while( table[ i ] != 0 ) i = ( i + 1 ) & mask;
+      table[ i ] = ref;
+   }
+
+   free( pool->table );
+   pool->table = table;
+   pool->bits = bits;
+   return true;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Prepara un almacén vacío (que sólo contiene a la cadena vacía).
+ *
+ * @return false si no hubo memoria.
+ */
+bool StrPool_Init( StrPool* pool )
+{
+   pool->cap = ARENA_MIN;
+   pool->chars = (char*) malloc( pool->cap );
+   pool->bits = TABLE_MIN_BITS;
+   pool->table = (StrRef*) calloc( 1 << pool->bits, sizeof( StrRef ) );
+   pool->count = 0;
+
+   if( !pool->chars || !pool->table )
+   {
+      StrPool_Free( pool );
+      return false;
+   }
+
+   pool->chars[ 0 ] = '\0';
+   pool->len = 1;
+   return true;
+}
+
+void StrPool_Free( StrPool* pool )
+{
+   free( pool->chars );
+   free( pool->table );
+   pool->chars = NULL;
+   pool->table = NULL;
+   pool->len = pool->cap = 0;
+   pool->count = 0;
+}
+
+/**
+ * @brief Devuelve la referencia de la cadena |s|, agregándola si no existía.
+ *
+ * @param pool    El almacén.
+ * @param s       La cadena; puede venir del mismo almacén (StrPool_Get()).
+ * @param max_len Si |s| es más larga, se guarda truncada a |max_len| caracteres.
+ *
+ * @return La referencia; STRPOOL_ERROR si no hubo memoria (el almacén queda
+ * sin cambios).
+ */
+StrRef StrPool_Intern( StrPool* pool, const char* s, size_t max_len )
+{
+   size_t len = strnlen( s, max_len );
+   if( len == 0 ) return 0;
+
+   uint32_t h = hash_str( s, len );
+   int i = lookup( pool, s, len, h );
+   if( pool->table[ i ] != 0 ) return pool->table[ i ];
+
+   if( pool->len + len + 1 > UINT32_MAX - 1 ) return STRPOOL_ERROR;
+
+   if( pool->len + len + 1 > pool->cap )
+   {
+      size_t cap = pool->cap * 2;
+      while( cap < pool->len + len + 1 ) cap *= 2;
+
+      // |s| puede venir de la misma arena (StrPool_Get()); se guarda su
+      // desplazamiento porque realloc() puede moverla
+      uintptr_t offset = (uintptr_t) s - (uintptr_t) pool->chars;
+      bool inside = offset < pool->len;
+
+      char* chars = (char*) realloc( pool->chars, cap );
+      if( !chars ) return STRPOOL_ERROR;
+
+      if( inside ) s = chars + offset;
+      pool->chars = chars;
+      pool->cap = cap;
+   }
+
+   if( 2 * ( pool->count + 1 ) > ( 1 << pool->bits ) )
+   {
+      // la tabla se mantiene a lo más a la mitad de su capacidad
+      if( !grow_table( pool ) ) return STRPOOL_ERROR;
+      i = lookup( pool, s, len, h );
+   }
+
+   StrRef ref = (StrRef) pool->len;
+   memcpy( pool->chars + ref, s, len );
+   pool->chars[ ref + len ] = '\0';
+   pool->len += len + 1;
+
+   pool->table[ i ] = ref;
+   ++pool->count;
+
+   return ref;
+}
@@ -0,0 +1,57 @@
+#ifndef  STRPOOL_INC
+#define  STRPOOL_INC
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Referencia a una cadena del almacén: su desplazamiento en la arena.
+ * La referencia 0 siempre es la cadena vacía.
+ */
+typedef uint32_t StrRef;
+
+/**
+ * @brief Valor que devuelve StrPool_Intern() cuando no hubo memoria.
+ */
+#define STRPOOL_ERROR ( (StrRef) -1 )
+
+/**
+ * @brief Almacén de cadenas sin repetir (interning).
+ *
+ * Cada cadena distinta se guarda una sola vez en una arena contigua, terminada
+ * en '\0', y se identifica por su desplazamiento. Muchos aeropuertos comparten
+ * país o ciudad, así que guardar una referencia de 4 bytes por campo ahorra la
+ * mayor parte de la memoria de los textos.
+ *
+ * El índice de búsqueda es una tabla hash con direccionamiento abierto, que se
+ * mantiene a lo más a la mitad de su capacidad.
+ */
+typedef struct
+{
+   char* chars;   ///< la arena
+   size_t len;    ///< bytes ocupados de la arena
+   size_t cap;    ///< bytes reservados para la arena
+
+   StrRef* table; ///< referencias dispersadas por el contenido de la cadena; 0 libre
+   int bits;      ///< la tabla tiene 2^bits entradas
+   int count;     ///< cadenas distintas (sin contar a la vacía)
+} StrPool;
+
+bool StrPool_Init( StrPool* pool );
+void StrPool_Free( StrPool* pool );
+
+StrRef StrPool_Intern( StrPool* pool, const char* s, size_t max_len );
+
+/**
+ * @brief Devuelve la cadena con la referencia |ref|.
+ *
+ * @warning La arena puede cambiar de lugar al agregar cadenas, así que el
+ * apuntador sólo es válido hasta la siguiente llamada a StrPool_Intern().
+ */
+static inline const char* StrPool_Get( const StrPool* pool, StrRef ref )
+{
+   return pool->chars + ref;
+}
+
+#endif   /* ----- #ifndef STRPOOL_INC  ----- */
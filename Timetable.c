@@ -0,0 +1,258 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Timetable.h"
+
+//----------------------------------------------------------------------
+//                     Funciones privadas
+//----------------------------------------------------------------------
+
+// deja la memoria de trabajo lista para una consulta nueva: sólo se limpian los
+// aeropuertos que tocó la consulta anterior
+static void scratch_reset( TimetableScratch* s )
+{
+   for( int i = 0; i < s->touched_len; ++i ) s->arrival[ s->touched[ i ] ] = INT_MAX;
+   s->touched_len = 0;
+   s->scanned = 0;
+}
+
+static void scratch_set( TimetableScratch* s, int v, int arrival, int via, int day )
+{
+   if( s->arrival[ v ] == INT_MAX ) s->touched[ s->touched_len++ ] = v;
+
+   s->arrival[ v ] = arrival;
+   s->via[ v ] = via;
+   s->via_day[ v ] = day;
+}
+
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Crea un itinerario vacío para los aeropuertos de |csr|.
+ *
+ * @param csr La copia congelada del grafo. Debe vivir más que el itinerario.
+ *
+ * @return El itinerario; NULL si no hubo memoria.
+ */
+Timetable* Timetable_New( const CSR* csr )
+{
+   Timetable* tt = (Timetable*) calloc( 1, sizeof( Timetable ) );
+   if( !tt ) return NULL;
+
+   tt->csr = csr;
+   tt->cap = 64;
+   tt->conns = (Connection*) malloc( tt->cap * sizeof( Connection ) );
+   if( !tt->conns )
+   {
+      free( tt );
+      return NULL;
+   }
+   tt->sorted = true;
+
+   return tt;
+}
+
+void Timetable_Delete( Timetable** p_tt )
+{
+   assert( *p_tt );
+
+   free( ( *p_tt )->conns );
+   free( *p_tt );
+   *p_tt = NULL;
+}
+
+/**
+ * @brief Agrega un vuelo diario.
+ *
+ * @param tt              El itinerario.
+ * @param from            Índice del aeropuerto de salida.
+ * @param to              Índice del aeropuerto de llegada.
+ * @param local_departure Hora de salida en minutos, en la hora local de |from|.
+ * @param duration        Duración del vuelo en minutos.
+ *
+ * @return false si no hubo memoria.
+ *
+ * @post Hay que llamar a Timetable_Sort() antes de la siguiente consulta.
+ */
+bool Timetable_AddFlight( Timetable* tt, int from, int to, int local_departure, int duration )
+{
+   assert( 0 <= from && from < tt->csr->len );
+   assert( 0 <= to && to < tt->csr->len );
+   assert( duration > 0 );
+
+   if( tt->count == tt->cap )
+   {
+      Connection* conns = (Connection*) realloc( tt->conns, 2 * tt->cap * sizeof( Connection ) );
+      if( !conns ) return false;
+
+      tt->conns = conns;
+      tt->cap *= 2;
+   }
+
+   int departure = Timetable_ToUtc( tt, from, local_departure ) % TIMETABLE_DAY;
+   if( departure < 0 ) departure += TIMETABLE_DAY;
+
+   Connection* c = &tt->conns[ tt->count++ ];
+   c->from = from;
+   c->to = to;
+   c->departure = departure;
+   c->duration = duration;
+
+   tt->sorted = false;
+   return true;
+}
+
+/**
+ * @brief Ordena los vuelos por hora de salida (conteo por minuto, O(n)).
+ *
+ * @return false si no hubo memoria; el itinerario queda sin ordenar.
+ */
+bool Timetable_Sort( Timetable* tt )
+{
+   if( tt->sorted ) return true;
+
+   Connection* sorted = (Connection*) malloc( tt->cap * sizeof( Connection ) );
+   if( !sorted ) return false;
+
+   memset( tt->first, 0, sizeof( tt->first ) );
+   for( int i = 0; i < tt->count; ++i ) ++tt->first[ tt->conns[ i ].departure + 1 ];
+   for( int m = 0; m < TIMETABLE_DAY; ++m ) tt->first[ m + 1 ] += tt->first[ m ];
+
+   int next[ TIMETABLE_DAY ];
+   memcpy( next, tt->first, sizeof( next ) );
+   for( int i = 0; i < tt->count; ++i ) sorted[ next[ tt->conns[ i ].departure ]++ ] = tt->conns[ i ];
+
+   free( tt->conns );
+   tt->conns = sorted;
+   tt->sorted = true;
+   return true;
+}
+
+bool TimetableScratch_Init( TimetableScratch* s, int len )
+{
+   s->len = len;
+   s->arrival = (int*) malloc( len * sizeof( int ) );
+   s->via = (int*) malloc( len * sizeof( int ) );
+   s->via_day = (int*) malloc( len * sizeof( int ) );
+   s->touched = (int*) malloc( len * sizeof( int ) );
+   s->touched_len = 0;
+   s->scanned = 0;
+
+   if( !s->arrival || !s->via || !s->via_day || !s->touched )
+   {
+      TimetableScratch_Free( s );
+      return false;
+   }
+
+   for( int i = 0; i < len; ++i ) s->arrival[ i ] = INT_MAX;
+   return true;
+}
+
+void TimetableScratch_Free( TimetableScratch* s )
+{
+   free( s->arrival );
+   free( s->via );
+   free( s->via_day );
+   free( s->touched );
+   s->arrival = s->via = s->via_day = s->touched = NULL;
+}
+
+/**
+ * @brief Calcula la hora de llegada más temprana a |dst| saliendo de |src| a
+ * la hora |departure| o después (escaneo de conexiones).
+ *
+ * Los vuelos se revisan una sola vez, en orden de salida, a partir de
+ * |departure|; se detiene en cuanto el siguiente vuelo sale después de la mejor
+ * llegada conocida a |dst|, o después de TIMETABLE_MAX_DAYS días. Entre dos
+ * vuelos se exigen TIMETABLE_MIN_CONNECTION minutos.
+ *
+ * @param tt        El itinerario, ordenado con Timetable_Sort().
+ * @param src       Índice del aeropuerto de salida.
+ * @param dst       Índice del aeropuerto de llegada.
+ * @param departure Hora a partir de la cual se puede salir, en minutos UTC (>= 0).
+ *                  Use Timetable_ToUtc() para convertir una hora local de |src|.
+ * @param s         Memoria de trabajo.
+ * @param legs      Recibe los tramos del viaje, en orden; puede ser NULL.
+ * @param legs_cap  Número de entradas de |legs|.
+ * @param legs_len  Recibe el número de tramos (0 si no hay forma de llegar). Si es
+ *                  mayor que |legs_cap|, |legs| no se escribió.
+ *
+ * @return La hora de llegada en minutos UTC (en la escala de |departure|); -1 si
+ * no se puede llegar en TIMETABLE_MAX_DAYS días.
+ */
+int Timetable_EarliestArrival( const Timetable* tt, int src, int dst, int departure, TimetableScratch* s,
+      TimetableLeg legs[], int legs_cap, int* legs_len )
+{
+   assert( tt->sorted );
+   assert( s->len >= tt->csr->len );
+   assert( 0 <= src && src < tt->csr->len );
+   assert( 0 <= dst && dst < tt->csr->len );
+   assert( departure >= 0 );
+
+   scratch_reset( s );
+   scratch_set( s, src, departure, -1, 0 );
+   if( legs_len ) *legs_len = 0;
+
+   int day = departure / TIMETABLE_DAY;
+   int last_day = day + TIMETABLE_MAX_DAYS;
+   int i = tt->first[ departure % TIMETABLE_DAY ];
+
+   while( src != dst && tt->count > 0 )
+   {
+      if( i == tt->count )
+      {
+         // el itinerario se repite al día siguiente
+         i = 0;
+         if( ++day > last_day ) break;
+      }
+
+      const Connection* c = &tt->conns[ i ];
+      int dep = day * TIMETABLE_DAY + c->departure;
+      if( dep >= s->arrival[ dst ] ) break;
+      // ningún vuelo posterior puede llegar antes
+
+      ++s->scanned;
+
+      int ready = s->arrival[ c->from ];
+      if( ready != INT_MAX )
+      {
+         if( c->from != src ) ready += TIMETABLE_MIN_CONNECTION;
+
+         int arr = dep + c->duration;
+         if( ready <= dep && arr < s->arrival[ c->to ] ) scratch_set( s, c->to, arr, i, day );
+      }
+      ++i;
+   }
+
+   if( s->arrival[ dst ] == INT_MAX ) return -1;
+
+   int count = 0;
+   for( int v = dst; v != src; v = tt->conns[ s->via[ v ] ].from ) ++count;
+   if( legs_len ) *legs_len = count;
+
+   if( legs && count <= legs_cap )
+   {
+      int k = count;
+      for( int v = dst; v != src; )
+      {
+         const Connection* c = &tt->conns[ s->via[ v ] ];
+         TimetableLeg* leg = &legs[ --k ];
+
+         leg->from = c->from;
+         leg->to = c->to;
+         leg->departure = s->via_day[ v ] * TIMETABLE_DAY + c->departure;
+         leg->arrival = leg->departure + c->duration;
+
+         v = c->from;
+      }
+   }
+
+   return s->arrival[ dst ];
+}
@@ -0,0 +1,116 @@
+#ifndef  TIMETABLE_INC
+#define  TIMETABLE_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "CSR.h"
+
+/**
+ * @brief Minutos de un día. El itinerario se repite todos los días.
+ */
+#define TIMETABLE_DAY 1440
+
+/**
+ * @brief Tiempo mínimo (minutos) para cambiar de vuelo en un aeropuerto.
+ */
+#ifndef TIMETABLE_MIN_CONNECTION
+#define TIMETABLE_MIN_CONNECTION 45
+#endif
+
+/**
+ * @brief Número máximo de días que puede durar un viaje. Acota la búsqueda
+ * cuando el destino no se alcanza.
+ */
+#ifndef TIMETABLE_MAX_DAYS
+#define TIMETABLE_MAX_DAYS 3
+#endif
+
+/**
+ * @brief Un vuelo del itinerario diario. Las horas están en minutos UTC.
+ */
+typedef struct
+{
+   int from;      ///< índice del aeropuerto de salida
+   int to;        ///< índice del aeropuerto de llegada
+   int departure; ///< hora de salida, en [0, TIMETABLE_DAY)
+   int duration;  ///< duración en minutos
+} Connection;
+
+/**
+ * @brief Itinerario diario de vuelos, ordenado por hora de salida, para el
+ * algoritmo de escaneo de conexiones (connection scan).
+ *
+ * Las horas locales se convierten a UTC con el huso horario de cada aeropuerto
+ * (Data.utc_time, en horas), así que todas las comparaciones son en UTC.
+ */
+typedef struct
+{
+   const CSR* csr;    ///< el grafo: número de aeropuertos y husos horarios
+   Connection* conns; ///< |count| vuelos ordenados por hora de salida
+   int count;
+   int cap;
+   int first[ TIMETABLE_DAY + 1 ]; ///< conns[ first[ m ] ] es el primer vuelo que sale en el minuto m o después
+   bool sorted;
+} Timetable;
+
+/**
+ * @brief Un tramo de un viaje. Las horas están en minutos UTC contados desde el
+ * día de la consulta (pueden ser mayores que TIMETABLE_DAY).
+ */
+typedef struct
+{
+   int from;
+   int to;
+   int departure;
+   int arrival;
+} TimetableLeg;
+
+/**
+ * @brief Memoria de trabajo de las consultas. Cada hilo debe tener la suya.
+ */
+typedef struct
+{
+   int len;
+   int* arrival;  ///< hora de llegada más temprana a cada aeropuerto; INT_MAX si no se alcanzó
+   int* via;      ///< vuelo (índice en conns) con el que se llegó
+   int* via_day;  ///< día de ese vuelo
+   int* touched;  ///< aeropuertos modificados en la consulta actual
+   int touched_len;
+   int scanned;   ///< vuelos revisados en la última consulta
+} TimetableScratch;
+
+Timetable* Timetable_New( const CSR* csr );
+void Timetable_Delete( Timetable** p_tt );
+
+bool Timetable_AddFlight( Timetable* tt, int from, int to, int local_departure, int duration );
+bool Timetable_Sort( Timetable* tt );
+
+bool TimetableScratch_Init( TimetableScratch* s, int len );
+void TimetableScratch_Free( TimetableScratch* s );
+
+int Timetable_EarliestArrival( const Timetable* tt, int src, int dst, int departure, TimetableScratch* s,
+      TimetableLeg legs[], int legs_cap, int* legs_len );
+
+/**
+ * @brief Convierte una hora UTC (minutos) a la hora local del aeropuerto |v|.
+ */
+static inline int Timetable_ToLocal( const Timetable* tt, int v, int utc )
+{
+   assert( 0 <= v && v < tt->csr->len );
+
+   return utc + tt->csr->data[ v ].utc_time * 60;
+}
+
+/**
+ * @brief Convierte una hora local del aeropuerto |v| (minutos) a UTC.
+ */
+static inline int Timetable_ToUtc( const Timetable* tt, int v, int local )
+{
+   assert( 0 <= v && v < tt->csr->len );
+
+   return local - tt->csr->data[ v ].utc_time * 60;
+}
+
+#endif   /* ----- #ifndef TIMETABLE_INC  ----- */
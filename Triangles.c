@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "Triangles.h"
+
+//----------------------------------------------------------------------
+//                     Funciones públicas
+//----------------------------------------------------------------------
+
+/**
+ * @brief Cuenta los triángulos de la red: tercias de aeropuertos conectados
+ * entre sí por rutas directas.
+ *
+ * Los vértices se ordenan por grado y cada arista se orienta del vértice de
+ * menor rango al de mayor rango; cada triángulo se cuenta una sola vez, desde
+ * su vértice de menor rango, intersecando (CSR_Intersect()) su lista orientada
+ * con la de cada uno de sus vecinos en ella. Así ninguna lista orientada tiene
+ * más de O(sqrt( aristas )) elementos y los hubs no se recorren una vez por
+ * cada uno de sus vecinos.
+ *
+ * @param csr La copia.
+ *
+ * @return El número de triángulos; -1 si no hubo memoria.
+ *
+ * @pre El grafo es no dirigido (cada ruta está en ambos sentidos).
+ */
+long Triangles_Count( const CSR* csr )
+{
+   int n = csr->len;
+   int max_degree = 0;
+   for( int v = 0; v < n; ++v )
+   {
+      if( CSR_Degree( csr, v ) > max_degree ) max_degree = CSR_Degree( csr, v );
+   }
+
+   int* rank = (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+   int* order = (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+   int* fill = (int*) malloc( ( n > 0 ? n : 1 ) * sizeof( int ) );
+   int* offsets = (int*) calloc( n + 1, sizeof( int ) );
+   int* count = (int*) calloc( max_degree + 2, sizeof( int ) );
+   int* targets = (int*) malloc( ( csr->edges > 0 ? csr->edges : 1 ) * sizeof( int ) );
+
+   if( !rank || !order || !fill || !offsets || !count || !targets )
+   {
+      free( rank );
+      free( order );
+      free( fill );
+      free( offsets );
+      free( count );
+      free( targets );
+      return -1;
+   }
+
+   // rango: posición en el orden por grado (ordenamiento por conteo, estable)
+   for( int v = 0; v < n; ++v ) ++count[ CSR_Degree( csr, v ) + 1 ];
+   for( int d = 0; d <= max_degree; ++d ) count[ d + 1 ] += count[ d ];
+   for( int v = 0; v < n; ++v )
+   {
+      int r = count[ CSR_Degree( csr, v ) ]++;
+      order[ r ] = v;
+      rank[ v ] = r;
+   }
+
+   // lista orientada del rango r: los rangos mayores de sus vecinos
+   for( int v = 0; v < n; ++v )
+   {
+      const int* nv = CSR_Neighbors( csr, v );
+      for( int k = 0; k < CSR_Degree( csr, v ); ++k ) offsets[ rank[ v ] + 1 ] += rank[ nv[ k ] ] > rank[ v ];
+   }
+   for( int r = 0; r < n; ++r ) offsets[ r + 1 ] += offsets[ r ];
+
+   // las listas se llenan recorriendo los rangos en orden creciente (con las
+   // aristas que llegan a cada uno), así que quedan ordenadas
+   memcpy( fill, offsets, n * sizeof( int ) );
+   for( int r = 0; r < n; ++r )
+   {
+      int w = order[ r ];
+      const int* nw = CSR_InNeighbors( csr, w );
+      for( int k = 0; k < CSR_InDegree( csr, w ); ++k )
+      {
+         int q = rank[ nw[ k ] ];
+         if( q < r ) targets[ fill[ q ]++ ] = r;
+      }
+   }
+
+   long total = 0;
+   for( int r = 0; r < n; ++r )
+   {
+      const int* a = targets + offsets[ r ];
+      int na = offsets[ r + 1 ] - offsets[ r ];
+
+      for( int k = 0; k < na; ++k )
+      {
+         int q = a[ k ];
+         total += CSR_Intersect( a + k + 1, na - k - 1, targets + offsets[ q ], offsets[ q + 1 ] - offsets[ q ], NULL );
+      }
+   }
+
+   free( rank );
+   free( order );
+   free( fill );
+   free( offsets );
+   free( count );
+   free( targets );
+   return total;
+}
+
+/**
+ * @brief Cuenta los triángulos en los que participa el aeropuerto u: pares de
+ * sus vecinos que tienen ruta directa entre sí. Junto con el grado da el
+ * coeficiente de agrupamiento del aeropuerto.
+ *
+ * @param csr La copia, con los renglones ordenados (ver CSR_Sort()).
+ * @param u   Índice del vértice.
+ *
+ * @return El número de triángulos que incluyen a u.
+ *
+ * @pre El grafo es no dirigido (cada ruta está en ambos sentidos).
+ */
+long Triangles_CountAt( const CSR* csr, int u )
+{
+   assert( csr->sorted );
+
+   const int* nu = CSR_Neighbors( csr, u );
+   int du = CSR_Degree( csr, u );
+   bool loop_u = CSR_HasEdge( csr, u, u );
+
+   long twice = 0;
+   for( int p = 0; p < du; ++p )
+   {
+      int v = nu[ p ];
+      if( v == u ) continue;
+
+      int c = CSR_Intersect( nu, du, CSR_Neighbors( csr, v ), CSR_Degree( csr, v ), NULL );
+
+      // los lazos (u -> u o v -> v) meten a u o a v en la intersección
+      if( loop_u && CSR_HasEdge( csr, v, u ) ) --c;
+      if( CSR_HasEdge( csr, v, v ) ) --c;
+
+      twice += c;
+   }
+   // cada triángulo {u, v, w} se encontró desde v y desde w
+   return twice / 2;
+}
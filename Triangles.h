@@ -0,0 +1,12 @@
+#ifndef  TRIANGLES_INC
+#define  TRIANGLES_INC
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "CSR.h"
+
+long Triangles_Count( const CSR* csr );
+long Triangles_CountAt( const CSR* csr, int u );
+
+#endif   /* ----- #ifndef TRIANGLES_INC  ----- */
@@ -0,0 +1,139 @@
+/*
+ * Benchmark: matriz de tiempos mínimos entre todo par de aeropuertos con
+ * Floyd–Warshall por bloques (Apsp_New()) contra correr Path_Dijkstra() desde
+ * cada origen. También mide guardar y volver a leer la matriz.
+ *
+ * La red es aleatoria y geográfica: cada aeropuerto tiene rutas hacia algunos
+ * de sus vecinos más cercanos y unas cuantas de larga distancia, con tiempos
+ * calculados igual que en Loader.c.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -march=native -pthread -I. bench/apsp_bench.c Apsp.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o apsp_bench
+ *
+ * Uso: ./apsp_bench [num_aeropuertos] [rutas_por_aeropuerto] [max_hilos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "Apsp.h"
+#include "Path.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 3000;
+   int degree   = argc > 2 ? atoi( argv[ 2 ] ) : 8;
+   int max_threads = argc > 3 ? atoi( argv[ 3 ] ) : (int) sysconf( _SC_NPROCESSORS_ONLN );
+
+   float* lat = (float*) malloc( airports * sizeof( float ) );
+   float* lon = (float*) malloc( airports * sizeof( float ) );
+   int routes = airports * degree;
+   int* src = (int*) malloc( routes * sizeof( int ) );
+   int* dst = (int*) malloc( routes * sizeof( int ) );
+   float* w = (float*) malloc( routes * sizeof( float ) );
+   if( !lat || !lon || !src || !dst || !w ) return 1;
+
+   srand( 42 );
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   for( int i = 0; i < airports; ++i )
+   {
+      // una región de 20 x 40 grados
+      lat[ i ] = 10.0f + 20.0f * rand() / RAND_MAX;
+      lon[ i ] = -110.0f + 40.0f * rand() / RAND_MAX;
+      Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+      Graph_SetLocation( g, i + 1, lat[ i ], lon[ i ] );
+   }
+
+   for( int r = 0; r < routes; ++r )
+   {
+      int a = r / degree;
+      int b = rand() % airports;
+      if( r % degree != 0 )
+      {
+         // ruta regional: el más cercano de unos cuantos candidatos
+         for( int t = 0; t < 16; ++t )
+         {
+            int c = rand() % airports;
+            if( Path_DistanceKm( lat[ a ], lon[ a ], lat[ c ], lon[ c ] ) < Path_DistanceKm( lat[ a ], lon[ a ], lat[ b ], lon[ b ] ) ) b = c;
+         }
+      }
+      src[ r ] = a;
+      dst[ r ] = b;
+      w[ r ] = Path_DistanceKm( lat[ a ], lon[ a ], lat[ b ], lon[ b ] ) / 800.0f + 0.5f;
+   }
+   Graph_AddEdgesByIndex( g, src, dst, w, routes );
+
+   CSR* csr = Graph_Freeze( g );
+   Graph_Delete( &g );
+   if( !csr ) return 1;
+
+   printf( "airports: %d, routes: %d, block: %d\n", csr->len, csr->edges, APSP_BLOCK );
+
+   // referencia: Dijkstra desde cada origen, escribiendo a una matriz densa
+   float* ref = (float*) malloc( (size_t) csr->len * csr->len * sizeof( float ) );
+   PathScratch s;
+   if( !ref || !PathScratch_Init( &s, csr->len ) ) return 1;
+
+   double t0 = now();
+   for( int u = 0; u < csr->len; ++u )
+   {
+      int path_len;
+      Path_Dijkstra( csr, u, -1, &s, NULL, 0, &path_len );
+      for( int v = 0; v < csr->len; ++v ) ref[ (size_t) u * csr->len + v ] = s.dist[ v ];
+   }
+   double t_dijkstra = now() - t0;
+   printf( "%-28s %10.3f s\n", "dijkstra from every source", t_dijkstra );
+
+   Apsp* apsp = NULL;
+   for( int threads = 1; threads <= max_threads; threads *= 2 )
+   {
+      if( apsp ) Apsp_Delete( &apsp );
+
+      t0 = now();
+      apsp = Apsp_New( csr, threads );
+      double t = now() - t0;
+      if( !apsp ) return 1;
+
+      float max_err = 0.0f;
+      long mismatched = 0;
+      for( int u = 0; u < csr->len; ++u )
+      {
+         for( int v = 0; v < csr->len; ++v )
+         {
+            float a = Apsp_Get( apsp, u, v ), b = ref[ (size_t) u * csr->len + v ];
+            if( isinf( a ) != isinf( b ) ) ++mismatched;
+            else if( !isinf( a ) && fabsf( a - b ) > max_err ) max_err = fabsf( a - b );
+         }
+      }
+
+      char label[ 64 ];
+      snprintf( label, sizeof( label ), "floyd-warshall, %d thread%s", threads, threads > 1 ? "s" : "" );
+      printf( "%-28s %10.3f s  (%.2fx, max error %.2g h, %ld reachability mismatches)\n",
+            label, t, t_dijkstra / t, max_err, mismatched );
+   }
+
+   const char* path = "/tmp/bench_apsp.bin";
+   t0 = now();
+   bool ok = Apsp_Save( apsp, path );
+   double t_save = now() - t0;
+
+   t0 = now();
+   Apsp* copy = ok ? Apsp_Load( path ) : NULL;
+   double t_load = now() - t0;
+
+   if( copy )
+   {
+      printf( "%-28s %10.3f s\n%-28s %10.3f s\n", "save", t_save, "load", t_load );
+      Apsp_Delete( &copy );
+   }
+   remove( path );
+
+   Apsp_Delete( &apsp );
+   PathScratch_Free( &s );
+   CSR_Delete( &csr );
+   free( ref ); free( lat ); free( lon ); free( src ); free( dst ); free( w );
+   return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef  BENCH_INC
+#define  BENCH_INC
+
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/**
+ * @brief Utilerías comunes a los benchmarks de bench/: el reloj y la
+ * generación de extremos con hubs. Cada benchmark incluye este archivo con
+ * #include "bench.h"; todo es static inline, así que no hay que enlazar nada
+ * más.
+ */
+
+// ret: el tiempo de un reloj monotónico, en segundos
+static inline double now( void )
+{
+   struct timespec ts;
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// índice en [0, n) a partir de |u| uniforme en [0, 1), con probabilidad
+// ~ 1/(i+1) (Zipf con exponente 1): unos cuantos hubs
+static inline int zipf_at( int n, double u )
+{
+   int i = (int) pow( n, u ) - 1;
+   return i < n ? i : n - 1;
+}
+
+// zipf_at() con rand() como fuente
+static inline int zipf( int n )
+{
+   return zipf_at( n, rand() / ( RAND_MAX + 1.0 ) );
+}
+
+#endif   /* ----- #ifndef BENCH_INC  ----- */
@@ -0,0 +1,128 @@
+/*
+ * Benchmark: búsqueda en amplitud en paralelo (Bfs_Run()) sobre grafos
+ * aleatorios de al menos un millón de vértices.
+ *
+ * Para cada número de hilos hace búsquedas desde varios orígenes, siempre de
+ * arriba hacia abajo y con cambio de dirección, y reporta aristas recorridas por
+ * segundo (las aristas que salen de los vértices alcanzados entre el tiempo,
+ * como en Graph500) además de las aristas que de verdad se revisaron. El
+ * resultado se compara contra una búsqueda secuencial sencilla.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/bfs_bench.c Bfs.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o bfs_bench
+ *
+ * Uso: ./bfs_bench [num_vertices] [num_aristas] [uniform|powerlaw] [max_hilos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "Bfs.h"
+#include "bench.h"
+
+// búsqueda secuencial de referencia
+static void reference( const CSR* csr, int src, int hops[], int queue[] )
+{
+   for( int i = 0; i < csr->len; ++i ) hops[ i ] = -1;
+
+   int head = 0, tail = 0;
+   hops[ src ] = 0;
+   queue[ tail++ ] = src;
+   while( head < tail )
+   {
+      int u = queue[ head++ ];
+      const int* t = CSR_Neighbors( csr, u );
+      for( int k = 0; k < CSR_Degree( csr, u ); ++k )
+      {
+         if( hops[ t[ k ] ] == -1 )
+         {
+            hops[ t[ k ] ] = hops[ u ] + 1;
+            queue[ tail++ ] = t[ k ];
+         }
+      }
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   int vertices = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+   int edges    = argc > 2 ? atoi( argv[ 2 ] ) : 10000000;
+   bool powerlaw = argc > 3 && strcmp( argv[ 3 ], "powerlaw" ) == 0;
+   int max_threads = argc > 4 ? atoi( argv[ 4 ] ) : (int) sysconf( _SC_NPROCESSORS_ONLN );
+   const int sources = 8;
+
+   Graph* g = Graph_New( vertices, eGraphType_DIRECTED );
+   if( !g ) return 1;
+   for( int i = 0; i < vertices; ++i ) Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+
+   int* src = (int*) malloc( edges * sizeof( int ) );
+   int* dst = (int*) malloc( edges * sizeof( int ) );
+   if( !src || !dst ) return 1;
+
+   srand( 42 );
+   for( int i = 0; i < edges; ++i )
+   {
+      src[ i ] = powerlaw ? zipf( vertices ) : rand() % vertices;
+      dst[ i ] = powerlaw ? zipf( vertices ) : rand() % vertices;
+   }
+   Graph_AddEdgesByIndex( g, src, dst, NULL, edges );
+   free( src );
+   free( dst );
+
+   CSR* csr = Graph_Freeze( g );
+   Graph_Delete( &g );
+   if( !csr ) return 1;
+
+   int* hops = (int*) malloc( csr->len * sizeof( int ) );
+   int* expected = (int*) malloc( csr->len * sizeof( int ) );
+   int* queue = (int*) malloc( csr->len * sizeof( int ) );
+   if( !hops || !expected || !queue ) return 1;
+
+   printf( "%s graph: %d vertices, %d edges\n", powerlaw ? "power-law" : "uniform", csr->len, csr->edges );
+   printf( "%8s %10s %12s %12s %14s %8s\n", "threads", "mode", "ms/search", "MTEPS", "examined/srch", "check" );
+
+   for( int threads = 1; threads <= max_threads; threads *= 2 )
+   {
+      Bfs* bfs = Bfs_New( csr, threads );
+      if( !bfs ) return 1;
+
+      for( int mode = 0; mode < 2; ++mode )
+      {
+         bfs->direction_optimizing = mode == 1;
+
+         double t = 0.0;
+         long reached_edges = 0, examined = 0;
+         bool ok = true;
+
+         for( int s = 0; s < sources; ++s )
+         {
+            int root = s * 7919 % csr->len;
+            // los vértices de grado alto quedan al principio en el grafo de ley de potencias
+
+            double t0 = now();
+            Bfs_Run( bfs, root, -1, hops );
+            t += now() - t0;
+
+            reached_edges += bfs->edges_reached;
+            examined += bfs->edges_examined;
+
+            reference( csr, root, expected, queue );
+            ok = ok && memcmp( hops, expected, csr->len * sizeof( int ) ) == 0;
+         }
+
+         printf( "%8d %10s %12.2f %12.1f %14ld %8s\n", threads, mode ? "direction" : "top-down",
+               t * 1e3 / sources, reached_edges / t * 1e-6, examined / sources, ok ? "ok" : "FAIL" );
+      }
+
+      Bfs_Delete( &bfs );
+   }
+
+   free( hops );
+   free( expected );
+   free( queue );
+   CSR_Delete( &csr );
+   return 0;
+}
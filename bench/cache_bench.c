@@ -0,0 +1,121 @@
+/*
+ * Benchmark: caché de respuestas del servidor con tráfico concentrado en unos
+ * cuantos pares de aeropuertos grandes.
+ *
+ * El 90% de las consultas sale de un conjunto de pares "calientes" (elegidos con
+ * distribución de Zipf) y el resto es aleatorio. Se mide el rendimiento y la
+ * tasa de aciertos cuando el grafo nunca cambia y cuando cambia el peso de una
+ * ruta cada cierto número de lotes (lo que invalida los cachés).
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/cache_bench.c Server.c Cache.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o cache_bench
+ *
+ * Uso: ./cache_bench [num_aeropuertos] [num_consultas] [pares_calientes] [hilos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Server.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 10000;
+   int queries  = argc > 2 ? atoi( argv[ 2 ] ) : 50000;
+   int hot      = argc > 3 ? atoi( argv[ 3 ] ) : 300;
+   int threads  = argc > 4 ? atoi( argv[ 4 ] ) : 1;
+
+   if( airports > IATA_INDEX_SIZE ) airports = IATA_INDEX_SIZE;
+
+   srand( 42 );
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   assert( g );
+   for( int i = 0; i < airports; ++i )
+   {
+      int k = (int)( ( i * 7919L ) % IATA_INDEX_SIZE );
+      char code[ 4 ] = { 'A' + k / 676, 'A' + k / 26 % 26, 'A' + k % 26, '\0' };
+      Graph_AddVertex( g, i, code, "", "", "", 0 );
+   }
+   for( long e = 0; e < (long) airports * 8; ++e )
+   {
+      Graph_AddWeightedEdge( g, rand() % airports, rand() % airports, 0.5f + ( rand() % 120 ) / 10.0f );
+   }
+
+   CSR* csr = Graph_Freeze( g );
+   assert( csr );
+
+   // los pares calientes son entre los 100 aeropuertos más grandes
+   int* hot_src = malloc( hot * sizeof( int ) );
+   int* hot_dst = malloc( hot * sizeof( int ) );
+   for( int h = 0; h < hot; ++h )
+   {
+      hot_src[ h ] = rand() % 100;
+      hot_dst[ h ] = rand() % 100;
+   }
+
+   char ( *text )[ 16 ] = malloc( queries * sizeof( *text ) );
+   const char** lines = malloc( queries * sizeof( char* ) );
+   for( int q = 0; q < queries; ++q )
+   {
+      int a, b;
+      if( rand() % 10 < 9 )
+      {
+         int h = zipf( hot );
+         a = hot_src[ h ];
+         b = hot_dst[ h ];
+      }
+      else
+      {
+         a = rand() % airports;
+         b = rand() % airports;
+      }
+      snprintf( text[ q ], 16, "P %s %s", Graph_GetIata( g, a ), Graph_GetIata( g, b ) );
+      lines[ q ] = text[ q ];
+   }
+
+   char ( *out )[ SERVER_LINE_MAX ] = malloc( SERVER_BATCH_MAX * sizeof( *out ) );
+
+   printf( "airports: %d, edges: %d, queries: %d, hot pairs: %d, cache entries per thread: %d\n",
+         csr->len, csr->edges, queries, hot, SERVER_CACHE_ENTRIES );
+   printf( "%-24s %12s %10s %10s %12s\n", "graph changes", "queries/s", "hit rate", "stale", "cache bytes" );
+
+   const int every[] = { 0, 10, 1 };
+   for( int m = 0; m < 3; ++m )
+   {
+      Server* srv = Server_New( csr, threads );
+      assert( srv );
+
+      double t0 = now();
+      for( int q = 0, batch = 0; q < queries; q += SERVER_BATCH_MAX, ++batch )
+      {
+         if( every[ m ] > 0 && batch % every[ m ] == 0 )
+         {
+            // un retraso: la primera ruta del aeropuerto 0 cambia de peso
+            CSR_SetEdgeWeight( csr, 0, csr->targets[ csr->offsets[ 0 ] ], 1.0f + batch % 7 );
+         }
+
+         int count = queries - q < SERVER_BATCH_MAX ? queries - q : SERVER_BATCH_MAX;
+         Server_AnswerBatch( srv, lines + q, count, out );
+      }
+      double t = now() - t0;
+
+      CacheStats st = Server_GetCacheStats( srv );
+      char label[ 32 ];
+      if( every[ m ] == 0 ) snprintf( label, sizeof( label ), "never" );
+      else snprintf( label, sizeof( label ), "every %d batch%s", every[ m ], every[ m ] > 1 ? "es" : "" );
+
+      printf( "%-24s %12.0f %9.1f%% %10ld %12zu\n", label, queries / t,
+            100.0 * st.hits / ( st.hits + st.misses ), st.stale, st.bytes );
+
+      Server_Delete( &srv );
+   }
+
+   free( out ); free( lines ); free( text ); free( hot_src ); free( hot_dst );
+   CSR_Delete( &csr );
+   Graph_Delete( &g );
+   return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Benchmark: recorrido de todos los vecinos de todos los vértices con el
+ * cursor de las listas (Vertex_Start/Vertex_Next) contra la copia CSR
+ * creada por Graph_Freeze().
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/csr_bench.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o csr_bench
+ *
+ * Uso: ./csr_bench [num_vertices] [grado] [pasadas]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "CSR.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int vertices = argc > 1 ? atoi( argv[ 1 ] ) : 200000;
+   int degree   = argc > 2 ? atoi( argv[ 2 ] ) : 16;
+   int passes   = argc > 3 ? atoi( argv[ 3 ] ) : 10;
+
+   Graph* g = Graph_New( vertices, eGraphType_DIRECTED );
+   assert( g );
+
+   for( int i = 0; i < vertices; ++i ) Graph_AddVertex( g, i, "", "", "", "", 0 );
+
+   // las aristas se insertan en orden aleatorio, como al cargar un archivo de
+   // rutas, así que los nodos de una misma lista quedan dispersos en el heap
+   srand( 42 );
+   long total = (long) vertices * degree;
+   for( long e = 0; e < total; ++e )
+   {
+      Graph_AddWeightedEdge( g, rand() % vertices, rand() % vertices, (float)( rand() % 100 ) / 10.0f );
+   }
+
+   double t0 = now();
+   CSR* csr = Graph_Freeze( g );
+   double t_freeze = now() - t0;
+   assert( csr );
+
+   double sum_list = 0.0;
+   t0 = now();
+   for( int p = 0; p < passes; ++p )
+   {
+      for( int i = 0; i < g->len; ++i )
+      {
+         Vertex* v = Graph_GetVertexByIndex( g, i );
+         if( !v->neighbors ) continue;
+
+         for( Vertex_Start( v ); !Vertex_End( v ); Vertex_Next( v ) )
+         {
+            sum_list += Vertex_GetNeighborWeight( v ) + Vertex_GetNeighborIndex( v );
+         }
+      }
+   }
+   double t_list = now() - t0;
+
+   double sum_csr = 0.0;
+   t0 = now();
+   for( int p = 0; p < passes; ++p )
+   {
+      for( int i = 0; i < csr->len; ++i )
+      {
+         const int* targets = CSR_Neighbors( csr, i );
+         const float* weights = CSR_Weights( csr, i );
+         int degree_i = CSR_Degree( csr, i );
+
+         for( int k = 0; k < degree_i; ++k ) sum_csr += weights[ k ] + targets[ k ];
+      }
+   }
+   double t_csr = now() - t0;
+
+   double visited = (double) csr->edges * passes;
+   printf( "vertices: %d, edges: %d, passes: %d\n", csr->len, csr->edges, passes );
+   printf( "freeze: %8.1f ms\n", t_freeze * 1e3 );
+   printf( "lists:  %8.2f ns/edge\n", t_list * 1e9 / visited );
+   printf( "csr:    %8.2f ns/edge\n", t_csr * 1e9 / visited );
+   printf( "speedup: %.1fx %s\n", t_list / t_csr, sum_list == sum_csr ? "(sums match)" : "(SUMS DIFFER)" );
+
+   CSR_Delete( &csr );
+   Graph_Delete( &g );
+   return 0;
+}
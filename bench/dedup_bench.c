@@ -0,0 +1,65 @@
+/*
+ * Benchmark: inserción arista por arista (Graph_AddWeightedEdge()) en un grafo
+ * con distribución de grados de ley de potencias, donde unos cuantos
+ * aeropuertos concentran la mayoría de las rutas. Cada inserción revisa si la
+ * arista ya existía.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/dedup_bench.c Graph.c Report.c List.c StrPool.c -lm -o dedup_bench
+ *
+ * Para comparar contra la revisión lineal de la lista, compile otra vez
+ * desactivando los conjuntos de vecinos:
+ *    gcc -O2 -pthread -I. -DVERTEX_SET_MIN_DEGREE=2147483647 bench/dedup_bench.c Graph.c Report.c List.c StrPool.c -lm -o dedup_bench_list
+ *
+ * Uso: ./dedup_bench [num_aeropuertos] [num_rutas]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+   int routes   = argc > 2 ? atoi( argv[ 2 ] ) : 2000000;
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   if( !g ) return 1;
+
+   for( int i = 0; i < airports; ++i ) Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+
+   int* src = (int*) malloc( routes * sizeof( int ) );
+   int* dst = (int*) malloc( routes * sizeof( int ) );
+   if( !src || !dst ) return 1;
+
+   srand( 42 );
+   for( int i = 0; i < routes; ++i )
+   {
+      src[ i ] = zipf( airports ) + 1;
+      dst[ i ] = zipf( airports ) + 1;
+   }
+
+   double t0 = now();
+   for( int i = 0; i < routes; ++i ) Graph_AddWeightedEdge( g, src[ i ], dst[ i ], 1.0f );
+   double t = now() - t0;
+
+   long edges = 0;
+   int max_degree = 0;
+   for( int i = 0; i < g->len; ++i )
+   {
+      edges += g->vertices[ i ].degree;
+      if( g->vertices[ i ].degree > max_degree ) max_degree = g->vertices[ i ].degree;
+   }
+
+   printf( "airports: %d, routes: %d, distinct edges: %ld, max degree: %d (set from degree %d)\n",
+         airports, routes, edges, max_degree, VERTEX_SET_MIN_DEGREE );
+   printf( "insert: %.3f s (%.0f ns/route)\n", t, t * 1e9 / routes );
+
+   Graph_Delete( &g );
+   free( src );
+   free( dst );
+   return 0;
+}
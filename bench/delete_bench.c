@@ -0,0 +1,121 @@
+/*
+ * Benchmark: semanas de operación simuladas. En cada ronda se retiran rutas
+ * (Graph_RemoveEdge()) y aeropuertos (Graph_RemoveVertex()), se abren otros
+ * tantos nuevos y, cada cierto número de rondas, se compacta el grafo
+ * (Graph_Compact()). Reporta el tiempo por borrado y la memoria ocupada en el
+ * heap; si los borrados son O(1) y la compactación evita la fragmentación,
+ * ambos se mantienen estables ronda tras ronda.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/delete_bench.c Graph.c Report.c List.c StrPool.c -lm -o delete_bench
+ *
+ * Uso: ./delete_bench [num_aeropuertos] [rutas_por_aeropuerto] [rondas] [rondas_entre_compactaciones]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <math.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 20000;
+   int per      = argc > 2 ? atoi( argv[ 2 ] ) : 10;
+   int rounds   = argc > 3 ? atoi( argv[ 3 ] ) : 40;
+   int every    = argc > 4 ? atoi( argv[ 4 ] ) : 5;
+
+   Graph* g = Graph_New( airports, eGraphType_UNDIRECTED );
+   int* ids = (int*) malloc( airports * sizeof( int ) );
+   // ids[ k ]: el id del k-ésimo aeropuerto abierto (los que cerraron se reemplazan)
+   if( !g || !ids ) return 1;
+
+   srand( 42 );
+   int next_id = 1;
+   for( int k = 0; k < airports; ++k )
+   {
+      ids[ k ] = next_id++;
+      Graph_AddVertex( g, ids[ k ], "", "", "", "", 0 );
+   }
+   for( int i = 0; i < airports * per; ++i )
+   {
+      Graph_AddWeightedEdge( g, ids[ zipf( airports ) ], ids[ zipf( airports ) ], 60.0f );
+   }
+
+   int churn = airports / 20;
+   // aeropuertos (y grupos de |per| rutas) que se reemplazan en cada ronda
+
+   printf( "%6s %10s %10s %12s %12s %10s %10s\n",
+           "ronda", "len", "lápidas", "ns/ruta", "ns/aerop.", "MB heap", "compact ms" );
+
+   for( int r = 1; r <= rounds; ++r )
+   {
+      // rutas que se retiran: se escogen entre las existentes, con hubs incluidos
+      int routes = churn * per;
+      int* from = (int*) malloc( routes * sizeof( int ) );
+      int* to   = (int*) malloc( routes * sizeof( int ) );
+      if( !from || !to ) return 1;
+
+      int found = 0;
+      for( int tries = 0; found < routes && tries < 20 * routes; ++tries )
+      {
+         int u = Graph_getIndexByValue( g, ids[ zipf( airports ) ] );
+         Vertex* v = Graph_GetVertexByIndex( g, u );
+         if( !v->neighbors || List_Is_empty( v->neighbors ) ) continue;
+
+         from[ found ] = g->ids[ u ];
+         to[ found ] = g->ids[ v->neighbors->last->data.index ];
+         ++found;
+      }
+
+      double t0 = now();
+      int removed_routes = 0;
+      for( int i = 0; i < found; ++i ) removed_routes += Graph_RemoveEdge( g, from[ i ], to[ i ] );
+      double t1 = now();
+
+      for( int i = 0; i < churn; ++i )
+      {
+         int k = rand() % airports;
+         Graph_RemoveVertex( g, ids[ k ] );
+         ids[ k ] = next_id++;
+      }
+      double t2 = now();
+
+      // los aeropuertos nuevos ocupan los lugares de los que cerraron
+      for( int k = 0; k < airports; ++k )
+      {
+         if( Graph_getIndexByValue( g, ids[ k ] ) == -1 ) Graph_AddVertex( g, ids[ k ], "", "", "", "", 0 );
+      }
+      for( int i = 0; i < routes; ++i )
+      {
+         Graph_AddWeightedEdge( g, ids[ zipf( airports ) ], ids[ zipf( airports ) ], 60.0f );
+      }
+
+      int len = g->len;
+      int tombstones = g->removed;
+
+      double tc = 0.0;
+      if( every > 0 && r % every == 0 )
+      {
+         double t3 = now();
+         Graph_Compact( g, NULL );
+         tc = ( now() - t3 ) * 1e3;
+      }
+
+      struct mallinfo2 mi = mallinfo2();
+
+      printf( "%6d %10d %10d %12.1f %12.1f %10.1f %10.2f\n", r, len, tombstones,
+              ( t1 - t0 ) * 1e9 / ( removed_routes > 0 ? removed_routes : 1 ),
+              ( t2 - t1 ) * 1e9 / churn,
+              mi.uordblks / 1e6, tc );
+
+      free( from );
+      free( to );
+   }
+
+   Graph_Delete( &g );
+   free( ids );
+   return 0;
+}
@@ -0,0 +1,445 @@
+/*
+ * Benchmark: operaciones básicas del grafo sobre redes de aeropuertos
+ * sintéticas de varios tamaños. Mide la inserción de vértices (empezando con
+ * capacidad 1), la inserción de aristas por id, el recorrido de las listas de
+ * vecinos, la búsqueda por id y la destrucción del grafo.
+ *
+ * Redes:
+ *    uniform   los extremos de cada ruta se escogen al azar
+ *    powerlaw  los extremos siguen una ley de Zipf: unos cuantos hubs
+ *              concentran la mayoría de las rutas
+ *    geo       aeropuertos al azar sobre la esfera; cada uno vuela a
+ *              aeropuertos de su celda o de las vecinas, con el tiempo de
+ *              vuelo como peso
+ *
+ * El resultado se escribe en JSON (un objeto por red y tamaño, con el mejor
+ * tiempo de las repeticiones en ns por operación) para poder comparar entre
+ * versiones; el avance se escribe en stderr.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    make graph_bench
+ * o bien
+ *    gcc -O2 -pthread -I. bench/graph_bench.c Graph.c Report.c List.c StrPool.c -lm -o graph_bench
+ *
+ * Uso: ./graph_bench [--sizes 1000,10000,100000] [--degree 8] [--repeat 3]
+ *                    [--networks uniform,powerlaw,geo] [--out resultados.json]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+#define MAX_SIZES 16
+
+// número de búsquedas por id en cada repetición
+#define LOOKUPS 1000000
+
+// número de recorridos completos de las listas de vecinos en cada repetición
+#define ITERATION_PASSES 5
+
+typedef enum { eNet_UNIFORM, eNet_POWERLAW, eNet_GEO, eNet_COUNT } eNetwork;
+
+static const char* network_names[ eNet_COUNT ] = { "uniform", "powerlaw", "geo" };
+
+// red sintética: los vértices y las aristas (por id) a insertar
+typedef struct
+{
+   int n;
+   int m;
+   int* src;
+   int* dst;
+   float* weight;
+   float* lat;
+   float* lon;
+} Network;
+
+// los tiempos de una repetición, en segundos
+typedef struct
+{
+   double vertex_insert;
+   double edge_insert;
+   double iteration;
+   double lookup;
+   double teardown;
+} Times;
+
+// generador xorshift64*: reproducible y sin depender de RAND_MAX
+static uint64_t rng_state = 42;
+
+static uint64_t rng_next( void )
+{
+   rng_state ^= rng_state >> 12;
+   rng_state ^= rng_state << 25;
+   rng_state ^= rng_state >> 27;
+   return rng_state * 2685821657736338717ull;
+}
+
+static double rng_unit( void )
+{
+   return ( rng_next() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+static int rng_below( int n )
+{
+   return (int)( rng_unit() * n );
+}
+
+// los ids no son consecutivos, como en los archivos de OpenFlights
+static int id_of( int i )
+{
+   return 3 * i + 1;
+}
+
+// tiempo de vuelo (minutos) entre dos puntos a 800 km/h, más 30 minutos de rodaje
+static float flight_minutes( float lat1, float lon1, float lat2, float lon2 )
+{
+   const double rad = M_PI / 180.0;
+   double dlat = ( lat2 - lat1 ) * rad;
+   double dlon = ( lon2 - lon1 ) * rad;
+   double a = sin( dlat / 2 ) * sin( dlat / 2 ) +
+              cos( lat1 * rad ) * cos( lat2 * rad ) * sin( dlon / 2 ) * sin( dlon / 2 );
+   double km = 2.0 * 6371.0 * asin( sqrt( a ) );
+   return (float)( 30.0 + km / 800.0 * 60.0 );
+}
+
+static void generate_geo( Network* net, int degree )
+{
+   int n = net->n;
+
+   // celdas de lat/lon con ~|degree| aeropuertos cada una
+   int cells = (int) sqrt( (double) n / degree );
+   if( cells < 1 ) cells = 1;
+
+   int* cell_start = (int*) calloc( cells * cells + 1, sizeof( int ) );
+   int* order = (int*) malloc( n * sizeof( int ) );
+   int* cell = (int*) malloc( n * sizeof( int ) );
+   if( !cell_start || !order || !cell ) exit( 1 );
+
+   for( int i = 0; i < n; ++i )
+   {
+      // uniforme sobre la esfera
+      net->lat[ i ] = (float)( asin( 2.0 * rng_unit() - 1.0 ) * 180.0 / M_PI );
+      net->lon[ i ] = (float)( 360.0 * rng_unit() - 180.0 );
+
+      int r = (int)( ( net->lat[ i ] + 90.0f ) / 180.0f * cells );
+      int c = (int)( ( net->lon[ i ] + 180.0f ) / 360.0f * cells );
+      if( r >= cells ) r = cells - 1;
+      if( c >= cells ) c = cells - 1;
+
+      cell[ i ] = r * cells + c;
+      ++cell_start[ cell[ i ] + 1 ];
+   }
+   for( int k = 0; k < cells * cells; ++k ) cell_start[ k + 1 ] += cell_start[ k ];
+   {
+      int* fill = (int*) malloc( cells * cells * sizeof( int ) );
+      if( !fill ) exit( 1 );
+      memcpy( fill, cell_start, cells * cells * sizeof( int ) );
+      for( int i = 0; i < n; ++i ) order[ fill[ cell[ i ] ]++ ] = i;
+      free( fill );
+   }
+
+   for( int e = 0; e < net->m; ++e )
+   {
+      int u = e / degree;
+      int r = cell[ u ] / cells + rng_below( 3 ) - 1;
+      int c = cell[ u ] % cells + rng_below( 3 ) - 1;
+      if( r < 0 ) r = 0;
+      if( r >= cells ) r = cells - 1;
+      c = ( c + cells ) % cells;
+      // la longitud da la vuelta
+
+      int k = r * cells + c;
+      int count = cell_start[ k + 1 ] - cell_start[ k ];
+      int v = count > 0 ? order[ cell_start[ k ] + rng_below( count ) ] : rng_below( n );
+
+      net->src[ e ] = id_of( u );
+      net->dst[ e ] = id_of( v );
+      net->weight[ e ] = flight_minutes( net->lat[ u ], net->lon[ u ], net->lat[ v ], net->lon[ v ] );
+   }
+
+   free( cell_start );
+   free( order );
+   free( cell );
+}
+
+static Network generate( eNetwork kind, int n, int degree )
+{
+   Network net;
+   net.n = n;
+   net.m = n * degree;
+   net.src = (int*) malloc( net.m * sizeof( int ) );
+   net.dst = (int*) malloc( net.m * sizeof( int ) );
+   net.weight = (float*) malloc( net.m * sizeof( float ) );
+   net.lat = (float*) malloc( n * sizeof( float ) );
+   net.lon = (float*) malloc( n * sizeof( float ) );
+   if( !net.src || !net.dst || !net.weight || !net.lat || !net.lon ) exit( 1 );
+
+   rng_state = 42 + (uint64_t) kind * 1000003u + (uint64_t) n;
+
+   switch( kind )
+   {
+   case eNet_UNIFORM:
+   case eNet_POWERLAW:
+      for( int i = 0; i < n; ++i ) net.lat[ i ] = net.lon[ i ] = NAN;
+      for( int e = 0; e < net.m; ++e )
+      {
+         int u = kind == eNet_UNIFORM ? rng_below( n ) : zipf_at( n, rng_unit() );
+         int v = kind == eNet_UNIFORM ? rng_below( n ) : zipf_at( n, rng_unit() );
+         net.src[ e ] = id_of( u );
+         net.dst[ e ] = id_of( v );
+         net.weight[ e ] = 30.0f + 600.0f * (float) rng_unit();
+      }
+      break;
+
+   case eNet_GEO:
+      generate_geo( &net, degree );
+      break;
+
+   default:
+      break;
+   }
+
+   return net;
+}
+
+static void network_free( Network* net )
+{
+   free( net->src );
+   free( net->dst );
+   free( net->weight );
+   free( net->lat );
+   free( net->lon );
+}
+
+// una repetición completa: construye, recorre, busca y destruye el grafo
+// ret: el número de aristas distintas que quedaron en el grafo
+static int run_once( const Network* net, const int queries[], Times* t, double* checksum )
+{
+   char iata[ 4 ] = "AAA";
+
+   double t0 = now();
+
+   Graph* g = Graph_New( 1, eGraphType_DIRECTED );
+   if( !g ) exit( 1 );
+
+   for( int i = 0; i < net->n; ++i )
+   {
+      int k = i % IATA_INDEX_SIZE;
+      iata[ 0 ] = 'A' + k / ( 26 * 26 );
+      iata[ 1 ] = 'A' + k / 26 % 26;
+      iata[ 2 ] = 'A' + k % 26;
+
+      if( !Graph_AddVertex( g, id_of( i ), iata, "", "", "", 0 ) ) exit( 1 );
+      if( !isnan( net->lat[ i ] ) ) Graph_SetLocation( g, id_of( i ), net->lat[ i ], net->lon[ i ] );
+   }
+
+   double t1 = now();
+
+   for( int e = 0; e < net->m; ++e ) Graph_AddWeightedEdge( g, net->src[ e ], net->dst[ e ], net->weight[ e ] );
+
+   double t2 = now();
+
+   int edges = 0;
+   double sum = 0.0;
+   for( int pass = 0; pass < ITERATION_PASSES; ++pass )
+   {
+      for( int i = 0; i < g->len; ++i )
+      {
+         for( List_Iterator it = Vertex_Begin( &g->vertices[ i ] ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+         {
+            Edge e = List_Iterator_get( it );
+            sum += e.weight + e.index;
+            ++edges;
+         }
+      }
+   }
+
+   double t3 = now();
+
+   long found = 0;
+   for( int q = 0; q < LOOKUPS; ++q ) found += Graph_getIndexByValue( g, queries[ q ] );
+
+   double t4 = now();
+
+   Graph_Delete( &g );
+
+   double t5 = now();
+
+   t->vertex_insert = t1 - t0;
+   t->edge_insert = t2 - t1;
+   t->iteration = t3 - t2;
+   t->lookup = t4 - t3;
+   t->teardown = t5 - t4;
+
+   *checksum += sum + found;
+   // para que el compilador no descarte los recorridos
+
+   return edges / ITERATION_PASSES;
+}
+
+static void print_metric( FILE* out, const char* name, double seconds, long ops, bool last )
+{
+   fprintf( out, "        \"%s\": { \"ops\": %ld, \"total_ms\": %.3f, \"ns_per_op\": %.2f }%s\n",
+            name, ops, seconds * 1e3, ops > 0 ? seconds * 1e9 / ops : 0.0, last ? "" : "," );
+}
+
+static double min_d( double a, double b )
+{
+   return a < b ? a : b;
+}
+
+// lee una lista separada por comas; ret: el número de elementos
+static int parse_sizes( const char* s, int sizes[] )
+{
+   int count = 0;
+   while( *s && count < MAX_SIZES )
+   {
+      char* end;
+      long v = strtol( s, &end, 10 );
+      if( end == s ) break;
+      if( v > 0 ) sizes[ count++ ] = (int) v;
+      s = *end == ',' ? end + 1 : end;
+   }
+   return count;
+}
+
+int main( int argc, char* argv[] )
+{
+   int sizes[ MAX_SIZES ] = { 1000, 10000, 100000 };
+   int num_sizes = 3;
+   int degree = 8;
+   int repeat = 3;
+   bool enabled[ eNet_COUNT ] = { true, true, true };
+   const char* out_path = NULL;
+
+   for( int i = 1; i < argc; ++i )
+   {
+      if( strcmp( argv[ i ], "--sizes" ) == 0 && i + 1 < argc )
+      {
+         num_sizes = parse_sizes( argv[ ++i ], sizes );
+      }
+      else if( strcmp( argv[ i ], "--degree" ) == 0 && i + 1 < argc )
+      {
+         degree = atoi( argv[ ++i ] );
+      }
+      else if( strcmp( argv[ i ], "--repeat" ) == 0 && i + 1 < argc )
+      {
+         repeat = atoi( argv[ ++i ] );
+      }
+      else if( strcmp( argv[ i ], "--networks" ) == 0 && i + 1 < argc )
+      {
+         const char* list = argv[ ++i ];
+         for( int k = 0; k < eNet_COUNT; ++k ) enabled[ k ] = strstr( list, network_names[ k ] ) != NULL;
+      }
+      else if( strcmp( argv[ i ], "--out" ) == 0 && i + 1 < argc )
+      {
+         out_path = argv[ ++i ];
+      }
+      else
+      {
+         fprintf( stderr, "Uso: %s [--sizes 1000,10000,100000] [--degree 8] [--repeat 3] "
+                  "[--networks uniform,powerlaw,geo] [--out resultados.json]\n", argv[ 0 ] );
+         return 1;
+      }
+   }
+
+   if( num_sizes == 0 || degree < 1 || repeat < 1 )
+   {
+      fprintf( stderr, "Parámetros inválidos\n" );
+      return 1;
+   }
+
+   FILE* out = out_path ? fopen( out_path, "w" ) : stdout;
+   if( !out )
+   {
+      perror( out_path );
+      return 1;
+   }
+
+   char date[ 32 ];
+   time_t t = time( NULL );
+   strftime( date, sizeof( date ), "%Y-%m-%dT%H:%M:%SZ", gmtime( &t ) );
+
+   fprintf( out, "{\n" );
+   fprintf( out, "  \"benchmark\": \"graph_bench\",\n" );
+   fprintf( out, "  \"schema\": 1,\n" );
+   fprintf( out, "  \"date\": \"%s\",\n", date );
+   fprintf( out, "  \"compiler\": \"%s\",\n", __VERSION__ );
+   fprintf( out, "  \"vertex_set_min_degree\": %d,\n", VERTEX_SET_MIN_DEGREE );
+   fprintf( out, "  \"degree\": %d,\n", degree );
+   fprintf( out, "  \"repeat\": %d,\n", repeat );
+   fprintf( out, "  \"results\": [\n" );
+
+   int* queries = (int*) malloc( LOOKUPS * sizeof( int ) );
+   if( !queries ) return 1;
+
+   double checksum = 0.0;
+   bool first = true;
+
+   for( int k = 0; k < eNet_COUNT; ++k )
+   {
+      if( !enabled[ k ] ) continue;
+
+      for( int s = 0; s < num_sizes; ++s )
+      {
+         int n = sizes[ s ];
+         Network net = generate( (eNetwork) k, n, degree );
+
+         // 1 de cada 8 búsquedas es por un id que no existe
+         for( int q = 0; q < LOOKUPS; ++q )
+         {
+            int i = rng_below( n );
+            queries[ q ] = q % 8 == 7 ? id_of( i ) + 1 : id_of( i );
+         }
+
+         Times best = { INFINITY, INFINITY, INFINITY, INFINITY, INFINITY };
+         int edges = 0;
+
+         for( int r = 0; r < repeat; ++r )
+         {
+            Times cur;
+            edges = run_once( &net, queries, &cur, &checksum );
+
+            best.vertex_insert = min_d( best.vertex_insert, cur.vertex_insert );
+            best.edge_insert = min_d( best.edge_insert, cur.edge_insert );
+            best.iteration = min_d( best.iteration, cur.iteration );
+            best.lookup = min_d( best.lookup, cur.lookup );
+            best.teardown = min_d( best.teardown, cur.teardown );
+         }
+
+         fprintf( stderr, "%-9s n=%-9d m=%-10d aristas=%-10d %.1f ms por construcción\n",
+                  network_names[ k ], n, net.m, edges, ( best.vertex_insert + best.edge_insert ) * 1e3 );
+
+         fprintf( out, "%s    {\n", first ? "" : ",\n" );
+         fprintf( out, "      \"network\": \"%s\",\n", network_names[ k ] );
+         fprintf( out, "      \"vertices\": %d,\n", n );
+         fprintf( out, "      \"routes\": %d,\n", net.m );
+         fprintf( out, "      \"edges\": %d,\n", edges );
+         fprintf( out, "      \"metrics\": {\n" );
+         print_metric( out, "vertex_insert", best.vertex_insert, n, false );
+         print_metric( out, "edge_insert", best.edge_insert, net.m, false );
+         print_metric( out, "neighbor_iteration", best.iteration / ITERATION_PASSES, edges, false );
+         print_metric( out, "lookup_by_id", best.lookup, LOOKUPS, false );
+         print_metric( out, "teardown", best.teardown, n, true );
+         fprintf( out, "      }\n" );
+         fprintf( out, "    }" );
+         first = false;
+
+         network_free( &net );
+      }
+   }
+
+   fprintf( out, "\n  ]\n}\n" );
+
+   if( out != stdout ) fclose( out );
+   free( queries );
+
+   fprintf( stderr, "checksum %g\n", checksum );
+   return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * Benchmark: inserción de muchos vértices en un grafo que empieza con
+ * capacidad 1 y crece solo. Reporta el tiempo de cada bloque de inserciones;
+ * si la inserción es O(1) amortizado, todos los bloques tardan lo mismo.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/grow_bench.c Graph.c Report.c List.c StrPool.c -lm -o grow_bench
+ *
+ * Uso: ./grow_bench [num_vertices] [num_bloques]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int vertices = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+   int blocks   = argc > 2 ? atoi( argv[ 2 ] ) : 10;
+
+   Graph* g = Graph_New( 1, eGraphType_DIRECTED );
+   assert( g );
+
+   int per_block = vertices / blocks;
+   double total = 0.0;
+
+   printf( "%10s %12s %12s\n", "vertices", "block ms", "ns/insert" );
+   for( int b = 0; b < blocks; ++b )
+   {
+      double t0 = now();
+      for( int i = 0; i < per_block; ++i )
+      {
+         int id = b * per_block + i;
+         char code[ 4 ] = { 'A' + id % 26, 'A' + id / 26 % 26, 'A' + id / 676 % 26, '\0' };
+         if( !Graph_AddVertex( g, id * 7 + 3, code, "Country", "City", "Airport", 0 ) ) return 1;
+      }
+      double t = now() - t0;
+      total += t;
+
+      printf( "%10d %12.2f %12.1f\n", g->len, t * 1e3, t * 1e9 / per_block );
+   }
+   printf( "total: %.2f ms, %.1f ns/insert, final capacity %d\n", total * 1e3, total * 1e9 / g->len, g->size );
+
+   // comprobación: todos los ids siguen encontrándose
+   for( int id = 0; id < g->len; ++id )
+   {
+      if( Graph_getIndexByValue( g, id * 7 + 3 ) != id ) return 1;
+   }
+
+   Graph_Delete( &g );
+   return 0;
+}
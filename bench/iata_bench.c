@@ -0,0 +1,83 @@
+/*
+ * Microbenchmark: búsqueda por código IATA con el índice del grafo
+ * (Graph_GetVertexByIata) contra un recorrido lineal con strcmp().
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/iata_bench.c Graph.c Report.c List.c StrPool.c -lm -o iata_bench
+ *
+ * Uso: ./iata_bench [num_aeropuertos] [num_consultas]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+static void make_code( int k, char code[ 4 ] )
+{
+   code[ 0 ] = 'A' + k / ( 26 * 26 ) % 26;
+   code[ 1 ] = 'A' + k / 26 % 26;
+   code[ 2 ] = 'A' + k % 26;
+   code[ 3 ] = '\0';
+}
+
+static int linear_scan( const Graph* g, const char iata[] )
+{
+   for( int i = 0; i < g->len; ++i )
+   {
+      if( strcmp( g->iata_codes[ i ], iata ) == 0 ) return i;
+   }
+   return -1;
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 10000;
+   int queries  = argc > 2 ? atoi( argv[ 2 ] ) : 1000000;
+
+   if( airports > IATA_INDEX_SIZE ) airports = IATA_INDEX_SIZE;
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   assert( g );
+
+   // los códigos se reparten de manera pseudo-aleatoria en el espacio de 26^3
+   for( int i = 0; i < airports; ++i )
+   {
+      char code[ 4 ];
+      make_code( (int)( ( i * 7919L ) % IATA_INDEX_SIZE ), code );
+      Graph_AddVertex( g, i, code, "Country", "City", "Airport", 0 );
+   }
+
+   char (*keys)[ 4 ] = malloc( (size_t) queries * sizeof( *keys ) );
+   srand( 42 );
+   for( int i = 0; i < queries; ++i )
+   {
+      strcpy( keys[ i ], g->iata_codes[ rand() % airports ] );
+   }
+
+   long check = 0;
+   double t0 = now();
+   for( int i = 0; i < queries; ++i ) check += Graph_GetIndexByIata( g, keys[ i ] );
+   double t_index = now() - t0;
+
+   // el recorrido lineal es mucho más lento; basta con una fracción de las consultas
+   int scan_queries = queries / 100 > 0 ? queries / 100 : 1;
+   long check_scan = 0, check_ref = 0;
+   t0 = now();
+   for( int i = 0; i < scan_queries; ++i ) check_scan += linear_scan( g, keys[ i ] );
+   double t_scan = now() - t0;
+   for( int i = 0; i < scan_queries; ++i ) check_ref += Graph_GetIndexByIata( g, keys[ i ] );
+
+   printf( "airports: %d\n", airports );
+   printf( "index:  %10.1f ns/query (%d queries)\n", t_index * 1e9 / queries, queries );
+   printf( "strcmp: %10.1f ns/query (%d queries)\n", t_scan * 1e9 / scan_queries, scan_queries );
+   printf( "speedup: %.0fx %s\n", ( t_scan / scan_queries ) / ( t_index / queries ),
+         check_scan == check_ref ? "(results match)" : "(RESULTS DIFFER)" );
+
+   (void) check;
+   free( keys );
+   Graph_Delete( &g );
+   return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * Benchmark: carga de archivos con formato de OpenFlights.
+ *
+ * Genera un airports.dat y un routes.dat sintéticos (en el directorio dado) y
+ * mide cuánto tarda Loader_OpenFlights() en crear el grafo.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/loader_bench.c Loader.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o loader_bench
+ *
+ * Uso: ./loader_bench [num_aeropuertos] [num_rutas] [directorio]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Loader.h"
+#include "bench.h"
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+   long routes  = argc > 2 ? atol( argv[ 2 ] ) : 10000000;
+   const char* dir = argc > 3 ? argv[ 3 ] : "/tmp";
+
+   char airports_path[ 512 ], routes_path[ 512 ];
+   snprintf( airports_path, sizeof( airports_path ), "%s/bench_airports.dat", dir );
+   snprintf( routes_path, sizeof( routes_path ), "%s/bench_routes.dat", dir );
+
+   srand( 42 );
+
+   FILE* f = fopen( airports_path, "w" );
+   if( !f ) return 1;
+   for( int i = 1; i <= airports; ++i )
+   {
+      int k = i % ( 26 * 26 * 26 );
+      fprintf( f, "%d,\"Airport %d\",\"City %d\",\"Country %d\",\"%c%c%c\",\"X%03d\",%.6f,%.6f,100,%d,\"U\",\"Etc/UTC\",\"airport\",\"OurAirports\"\n",
+            i, i, i % 5000, i % 200, 'A' + k / 676, 'A' + k / 26 % 26, 'A' + k % 26, i % 1000,
+            -60.0 + 120.0 * rand() / RAND_MAX, -180.0 + 360.0 * rand() / RAND_MAX, rand() % 25 - 12 );
+   }
+   fclose( f );
+
+   f = fopen( routes_path, "w" );
+   if( !f ) return 1;
+   for( long r = 0; r < routes; ++r )
+   {
+      int a = 1 + rand() % airports, b = 1 + rand() % airports;
+      fprintf( f, "XX,%d,AAA,%d,BBB,%d,,0,320\n", (int)( r % 900 ), a, b );
+   }
+   fclose( f );
+
+   double t0 = now();
+   Graph* g = Loader_OpenFlights( airports_path, routes_path, eGraphType_DIRECTED );
+   double t = now() - t0;
+   if( !g ) return 1;
+
+   long edges = 0;
+   for( int i = 0; i < g->len; ++i )
+   {
+      for( List_Iterator it = Vertex_Begin( &g->vertices[ i ] ); !List_Iterator_end( it ); List_Iterator_next( &it ) ) ++edges;
+   }
+
+   printf( "airports: %d, routes in file: %ld, edges loaded: %ld\n", g->len, routes, edges );
+   printf( "load: %.3f s (%.0f routes/s)\n", t, routes / t );
+
+   Graph_Delete( &g );
+   remove( airports_path );
+   remove( routes_path );
+   return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Benchmark: pares por segundo al preguntar si hay ruta directa entre dos
+ * aeropuertos. Compara is_Neighbor_Of() en un ciclo contra el lote
+ * Graph_AreNeighbors() con dos mezclas de pares: orígenes al azar y orígenes
+ * concentrados en unos cuantos hubs (como las consultas del cotizador). La
+ * mitad de los pares son rutas que existen. Revisa que ambas respuestas
+ * coincidan.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/neighbor_bench.c Graph.c Report.c List.c StrPool.c -lm -o neighbor_bench
+ *
+ * Uso: ./neighbor_bench [num_aeropuertos] [rutas_por_aeropuerto] [num_pares] [repeticiones]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+// llena los pares; con |hubs| > 0 los orígenes salen de los primeros |hubs| aeropuertos
+static void make_pairs( Graph* g, int airports, int hubs, int src[], int dst[], int n )
+{
+   for( int i = 0; i < n; ++i )
+   {
+      int u = hubs > 0 ? zipf( hubs ) : rand() % airports;
+      src[ i ] = u + 1;
+      dst[ i ] = rand() % airports + 1;
+
+      const Vertex* v = Graph_GetVertexByIndex( g, Graph_getIndexByValue( g, src[ i ] ) );
+      if( i % 2 == 0 && v->neighbors && !List_Is_empty( v->neighbors ) )
+      {
+         // una ruta que existe: alguno de los vecinos
+         int k = rand() % v->degree;
+         Node* it = v->neighbors->first;
+         while( k-- > 0 ) it = it->next;
+         dst[ i ] = g->ids[ it->data.index ];
+      }
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+   int per      = argc > 2 ? atoi( argv[ 2 ] ) : 10;
+   int n        = argc > 3 ? atoi( argv[ 3 ] ) : 100000;
+   int repeat   = argc > 4 ? atoi( argv[ 4 ] ) : 5;
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   int* src = (int*) malloc( n * sizeof( int ) );
+   int* dst = (int*) malloc( n * sizeof( int ) );
+   bool* expected = (bool*) malloc( n * sizeof( bool ) );
+   bool* actual = (bool*) malloc( n * sizeof( bool ) );
+   if( !g || !src || !dst || !expected || !actual ) return 1;
+
+   srand( 42 );
+   for( int i = 0; i < airports; ++i ) Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+   for( long i = 0; i < (long) airports * per; ++i )
+   {
+      Graph_AddWeightedEdge( g, zipf( airports ) + 1, rand() % airports + 1, 60.0f );
+   }
+
+   printf( "%d aeropuertos, %d rutas por aeropuerto, lotes de %d pares\n", airports, per, n );
+   printf( "%-16s %16s %16s %10s %10s\n", "orígenes", "ciclo Mpares/s", "lote Mpares/s", "aceleración", "iguales" );
+
+   static const char* names[] = { "al azar", "100 hubs", "10 hubs" };
+   static const int hubs[] = { 0, 100, 10 };
+
+   for( int w = 0; w < 3; ++w )
+   {
+      make_pairs( g, airports, hubs[ w ], src, dst, n );
+
+      double loop = 1e30, batch = 1e30;
+      int found_loop = 0, found_batch = 0;
+      for( int r = 0; r < repeat; ++r )
+      {
+         double t0 = now();
+         found_loop = 0;
+         for( int i = 0; i < n; ++i )
+         {
+            expected[ i ] = is_Neighbor_Of( g, dst[ i ], src[ i ] );
+            found_loop += expected[ i ];
+         }
+         double t1 = now();
+         found_batch = Graph_AreNeighbors( g, src, dst, n, actual );
+         double t2 = now();
+
+         if( found_batch < 0 ) return 1;
+         if( t1 - t0 < loop ) loop = t1 - t0;
+         if( t2 - t1 < batch ) batch = t2 - t1;
+      }
+
+      bool same = found_loop == found_batch;
+      for( int i = 0; i < n && same; ++i ) same = expected[ i ] == actual[ i ];
+
+      printf( "%-16s %16.2f %16.2f %10.2fx %10s\n", names[ w ],
+              n / loop / 1e6, n / batch / 1e6, loop / batch, same ? "sí" : "NO" );
+   }
+
+   Graph_Delete( &g );
+   free( src );
+   free( dst );
+   free( expected );
+   free( actual );
+   return 0;
+}
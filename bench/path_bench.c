@@ -0,0 +1,193 @@
+/*
+ * Benchmark: consultas punto a punto de camino más rápido sobre una red
+ * sintética de tamaño continental, con Dijkstra, Dijkstra bidireccional y A*.
+ * Reporta la latencia y el número de vértices asentados por consulta.
+ *
+ * Los aeropuertos se colocan al azar sobre Norteamérica y cada uno se conecta
+ * con sus vecinos geográficos más cercanos; la duración de cada vuelo es la
+ * distancia entre una velocidad de crucero más un tiempo fijo de rodaje.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/path_bench.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o path_bench
+ *
+ * Uso: ./path_bench [num_aeropuertos] [vecinos_por_aeropuerto] [num_consultas]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Path.h"
+#include "bench.h"
+
+#define LAT_MIN  15.0
+#define LAT_MAX  55.0
+#define LON_MIN -125.0
+#define LON_MAX  -65.0
+
+static double uniform( double lo, double hi )
+{
+   return lo + ( hi - lo ) * ( rand() / ( RAND_MAX + 1.0 ) );
+}
+
+/*
+ * Crea la red: |airports| aeropuertos, cada uno con vuelos de ida y vuelta hacia
+ * sus |k| vecinos más cercanos (buscados en una rejilla de 1 grado).
+ */
+static Graph* make_network( int airports, int k, double lat[], double lon[] )
+{
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   assert( g );
+
+   int rows = (int)( LAT_MAX - LAT_MIN ), cols = (int)( LON_MAX - LON_MIN );
+   int* cell_start = calloc( rows * cols + 1, sizeof( int ) );
+   int* cell_items = malloc( airports * sizeof( int ) );
+   int* cell_of = malloc( airports * sizeof( int ) );
+
+   for( int i = 0; i < airports; ++i )
+   {
+      lat[ i ] = uniform( LAT_MIN, LAT_MAX );
+      lon[ i ] = uniform( LON_MIN, LON_MAX );
+      cell_of[ i ] = (int)( lat[ i ] - LAT_MIN ) * cols + (int)( lon[ i ] - LON_MIN );
+      ++cell_start[ cell_of[ i ] + 1 ];
+
+      Graph_AddVertex( g, i, "", "", "", "", 0 );
+      Graph_SetLocation( g, i, lat[ i ], lon[ i ] );
+   }
+   for( int c = 0; c < rows * cols; ++c ) cell_start[ c + 1 ] += cell_start[ c ];
+   int* fill = malloc( rows * cols * sizeof( int ) );
+   for( int c = 0; c < rows * cols; ++c ) fill[ c ] = cell_start[ c ];
+   for( int i = 0; i < airports; ++i ) cell_items[ fill[ cell_of[ i ] ]++ ] = i;
+
+   int* best = malloc( k * sizeof( int ) );
+   double* best_d = malloc( k * sizeof( double ) );
+
+   for( int i = 0; i < airports; ++i )
+   {
+      int found = 0;
+      int r0 = cell_of[ i ] / cols, c0 = cell_of[ i ] % cols;
+
+      for( int radius = 1; found < k && radius < rows + cols; ++radius )
+      {
+         found = 0;
+         for( int r = r0 - radius; r <= r0 + radius; ++r )
+         {
+            for( int c = c0 - radius; c <= c0 + radius; ++c )
+            {
+               if( r < 0 || r >= rows || c < 0 || c >= cols ) continue;
+
+               for( int t = cell_start[ r * cols + c ]; t < cell_start[ r * cols + c + 1 ]; ++t )
+               {
+                  int j = cell_items[ t ];
+                  if( j == i ) continue;
+
+                  double d = Path_DistanceKm( lat[ i ], lon[ i ], lat[ j ], lon[ j ] );
+
+                  // inserción ordenada en los k mejores
+                  int p = found < k ? found++ : k;
+                  while( p > 0 && best_d[ p - 1 ] > d )
+                  {
+                     if( p < k ) { best[ p ] = best[ p - 1 ]; best_d[ p ] = best_d[ p - 1 ]; }
+                     --p;
+                  }
+                  if( p < k ) { best[ p ] = j; best_d[ p ] = d; }
+               }
+            }
+         }
+      }
+
+      for( int n = 0; n < found; ++n )
+      {
+         float hours = (float)( best_d[ n ] / 850.0 * uniform( 1.0, 1.2 ) + 0.5 );
+         Graph_AddWeightedEdge( g, i, best[ n ], hours );
+         Graph_AddWeightedEdge( g, best[ n ], i, hours );
+      }
+   }
+
+   free( best );
+   free( best_d );
+   free( fill );
+   free( cell_start );
+   free( cell_items );
+   free( cell_of );
+
+   return g;
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 50000;
+   int k        = argc > 2 ? atoi( argv[ 2 ] ) : 6;
+   int queries  = argc > 3 ? atoi( argv[ 3 ] ) : 1000;
+
+   srand( 42 );
+
+   double* lat = malloc( airports * sizeof( double ) );
+   double* lon = malloc( airports * sizeof( double ) );
+   Graph* g = make_network( airports, k, lat, lon );
+   CSR* csr = Graph_Freeze( g );
+   assert( csr );
+
+   PathScratch s, t;
+   if( !PathScratch_Init( &s, csr->len ) || !PathScratch_Init( &t, csr->len ) ) return 1;
+
+   int* src = malloc( queries * sizeof( int ) );
+   int* dst = malloc( queries * sizeof( int ) );
+   float* expected = malloc( queries * sizeof( float ) );
+   for( int q = 0; q < queries; ++q )
+   {
+      src[ q ] = rand() % csr->len;
+      dst[ q ] = rand() % csr->len;
+   }
+
+   printf( "airports: %d, edges: %d, queries: %d\n", csr->len, csr->edges, queries );
+
+   const char* names[] = { "dijkstra", "bidirectional", "astar" };
+   double base = 0.0;
+   for( int mode = 0; mode < 3; ++mode )
+   {
+      int path[ 1024 ];
+      long settled = 0;
+      int mismatches = 0;
+
+      double t0 = now();
+      for( int q = 0; q < queries; ++q )
+      {
+         int len;
+         float d;
+         switch( mode )
+         {
+            case 0:
+               d = Path_Dijkstra( csr, src[ q ], dst[ q ], &s, path, 1024, &len );
+               settled += s.settled;
+               expected[ q ] = d;
+               break;
+            case 1:
+               d = Path_Bidirectional( csr, src[ q ], dst[ q ], &s, &t, path, 1024, &len );
+               settled += s.settled + t.settled;
+               break;
+            default:
+               d = Path_AStar( csr, src[ q ], dst[ q ], &s, path, 1024, &len );
+               settled += s.settled;
+               break;
+         }
+         if( fabsf( d - expected[ q ] ) > 1e-3f * expected[ q ] ) ++mismatches;
+      }
+      double t = now() - t0;
+      if( mode == 0 ) base = t;
+
+      printf( "%-14s %8.3f ms/query, %9.0f settled/query, %.1fx, %d mismatches\n",
+            names[ mode ], t * 1e3 / queries, (double) settled / queries, base / t, mismatches );
+   }
+
+   free( expected );
+   PathScratch_Free( &t );
+   PathScratch_Free( &s );
+   free( src );
+   free( dst );
+   free( lat );
+   free( lon );
+   CSR_Delete( &csr );
+   Graph_Delete( &g );
+   return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Benchmark: construcción y destrucción de un grafo grande, contando las
+ * llamadas a malloc()/free() que hace el programa.
+ *
+ * Las llamadas se cuentan envolviendo malloc, calloc y free con el enlazador,
+ * así que hay que compilar así desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/pool_bench.c Graph.c Report.c List.c StrPool.c \
+ *        -Wl,--wrap=malloc,--wrap=calloc,--wrap=free -lm -o pool_bench
+ *
+ * Uso: ./pool_bench [num_vertices] [aristas_por_vertice]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graph.h"
+#include "bench.h"
+
+void* __real_malloc( size_t size );
+void* __real_calloc( size_t n, size_t size );
+void __real_free( void* p );
+
+static long mallocs = 0;
+static long frees = 0;
+
+void* __wrap_malloc( size_t size )
+{
+   ++mallocs;
+   return __real_malloc( size );
+}
+
+void* __wrap_calloc( size_t n, size_t size )
+{
+   ++mallocs;
+   return __real_calloc( n, size );
+}
+
+void __wrap_free( void* p )
+{
+   if( p ) ++frees;
+   __real_free( p );
+}
+
+int main( int argc, char* argv[] )
+{
+   int vertices = argc > 1 ? atoi( argv[ 1 ] ) : 1000000;
+   int degree   = argc > 2 ? atoi( argv[ 2 ] ) : 10;
+
+   double t0 = now();
+   Graph* g = Graph_New( vertices, eGraphType_DIRECTED );
+   assert( g );
+
+   for( int i = 0; i < vertices; ++i ) Graph_AddVertex( g, i, "", "", "", "", 0 );
+
+   // las aristas llegan en orden aleatorio, intercaladas entre vértices
+   unsigned seed = 42;
+   long total = (long) vertices * degree;
+   for( long e = 0; e < total; ++e )
+   {
+      seed = seed * 1103515245u + 12345u;
+      int u = ( seed >> 8 ) % vertices;
+      seed = seed * 1103515245u + 12345u;
+      int v = ( seed >> 8 ) % vertices;
+      Graph_AddWeightedEdge( g, u, v, 1.0f );
+   }
+   double t_build = now() - t0;
+   long build_mallocs = mallocs;
+
+   t0 = now();
+   Graph_Delete( &g );
+   double t_delete = now() - t0;
+
+   printf( "vertices: %d, edge insertions: %ld\n", vertices, total );
+   printf( "build:    %8.2f s, %9ld allocations\n", t_build, build_mallocs );
+   printf( "teardown: %8.2f s, %9ld frees\n", t_delete, frees );
+   return 0;
+}
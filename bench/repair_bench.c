@@ -0,0 +1,163 @@
+/*
+ * Benchmark: reparar árboles de caminos más cortos (Path_RepairTree()) contra
+ * recalcularlos con Path_Dijkstra() cuando cambian los tiempos de vuelo.
+ *
+ * La red es geográfica (como en apsp_bench). Se mantienen árboles desde varios
+ * aeropuertos y se aplica una traza de cambios: retrasos (el tiempo de una ruta
+ * al azar sube entre 5% y 100%) y recuperaciones (una ruta retrasada vuelve a
+ * su tiempo original). Cada tanto se verifica que los árboles reparados
+ * coincidan con los recalculados.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/repair_bench.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o repair_bench
+ *
+ * Uso: ./repair_bench [num_aeropuertos] [rutas_por_aeropuerto] [num_arboles] [num_cambios]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Path.h"
+#include "bench.h"
+
+static double uniform( void )
+{
+   return rand() / ( RAND_MAX + 1.0 );
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 20000;
+   int degree   = argc > 2 ? atoi( argv[ 2 ] ) : 8;
+   int trees    = argc > 3 ? atoi( argv[ 3 ] ) : 16;
+   int updates  = argc > 4 ? atoi( argv[ 4 ] ) : 20000;
+   const int check_every = 2000;
+
+   float* lat = (float*) malloc( airports * sizeof( float ) );
+   float* lon = (float*) malloc( airports * sizeof( float ) );
+   int routes = airports * degree;
+   int* src = (int*) malloc( routes * sizeof( int ) );
+   int* dst = (int*) malloc( routes * sizeof( int ) );
+   float* w = (float*) malloc( routes * sizeof( float ) );
+   if( !lat || !lon || !src || !dst || !w ) return 1;
+
+   srand( 42 );
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   for( int i = 0; i < airports; ++i )
+   {
+      lat[ i ] = -50.0f + 110.0f * uniform();
+      lon[ i ] = -180.0f + 360.0f * uniform();
+      Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+   }
+   for( int r = 0; r < routes; ++r )
+   {
+      int a = r / degree, b = rand() % airports;
+      if( r % degree != 0 )
+      {
+         for( int t = 0; t < 16; ++t )
+         {
+            int c = rand() % airports;
+            if( Path_DistanceKm( lat[ a ], lon[ a ], lat[ c ], lon[ c ] ) < Path_DistanceKm( lat[ a ], lon[ a ], lat[ b ], lon[ b ] ) ) b = c;
+         }
+      }
+      src[ r ] = a;
+      dst[ r ] = b;
+      w[ r ] = Path_DistanceKm( lat[ a ], lon[ a ], lat[ b ], lon[ b ] ) / 800.0f + 0.5f;
+   }
+   Graph_AddEdgesByIndex( g, src, dst, w, routes );
+
+   CSR* csr = Graph_Freeze( g );
+   Graph_Delete( &g );
+   if( !csr ) return 1;
+
+   // las aristas por posición en la CSR y su tiempo original
+   int* edge_src = (int*) malloc( csr->edges * sizeof( int ) );
+   float* base = (float*) malloc( csr->edges * sizeof( float ) );
+   int* delayed = (int*) malloc( csr->edges * sizeof( int ) );
+   int delayed_len = 0;
+   PathScratch* tree = (PathScratch*) malloc( trees * sizeof( PathScratch ) );
+   int* roots = (int*) malloc( trees * sizeof( int ) );
+   PathScratch check;
+   if( !edge_src || !base || !delayed || !tree || !roots || !PathScratch_Init( &check, csr->len ) ) return 1;
+
+   for( int u = 0; u < csr->len; ++u )
+   {
+      for( int k = csr->offsets[ u ]; k < csr->offsets[ u + 1 ]; ++k ) edge_src[ k ] = u;
+   }
+   for( int k = 0; k < csr->edges; ++k ) base[ k ] = csr->weights[ k ];
+
+   double t0 = now();
+   for( int t = 0; t < trees; ++t )
+   {
+      roots[ t ] = rand() % csr->len;
+      if( !PathScratch_Init( &tree[ t ], csr->len ) ) return 1;
+      Path_Dijkstra( csr, roots[ t ], -1, &tree[ t ], NULL, 0, NULL );
+   }
+   double t_full = ( now() - t0 ) / trees;
+
+   double t_repair = 0.0;
+   long settled = 0, touched_trees = 0;
+   int mismatches = 0, checks = 0;
+
+   for( int i = 1; i <= updates; ++i )
+   {
+      int k;
+      float nw;
+      if( delayed_len > 0 && uniform() < 0.4 )
+      {
+         // recuperación: una ruta retrasada vuelve a su tiempo original
+         int j = rand() % delayed_len;
+         k = delayed[ j ];
+         delayed[ j ] = delayed[ --delayed_len ];
+         nw = base[ k ];
+      }
+      else
+      {
+         k = rand() % csr->edges;
+         if( csr->weights[ k ] == base[ k ] ) delayed[ delayed_len++ ] = k;
+         nw = csr->weights[ k ] * (float)( 1.05 + 0.95 * uniform() );
+      }
+
+      int u = edge_src[ k ], v = csr->targets[ k ];
+
+      t0 = now();
+      float old = CSR_SetEdgeWeight( csr, u, v, nw );
+      for( int t = 0; t < trees; ++t )
+      {
+         Path_RepairTree( csr, &tree[ t ], u, v, old, nw );
+         settled += tree[ t ].settled;
+         if( tree[ t ].settled > 0 ) ++touched_trees;
+      }
+      t_repair += now() - t0;
+
+      if( i % check_every == 0 )
+      {
+         for( int t = 0; t < trees; ++t )
+         {
+            Path_Dijkstra( csr, roots[ t ], -1, &check, NULL, 0, NULL );
+            for( int x = 0; x < csr->len; ++x )
+            {
+               float a = tree[ t ].dist[ x ], b = check.dist[ x ];
+               if( isinf( a ) != isinf( b ) || ( !isinf( a ) && fabsf( a - b ) > 1e-3f * b ) ) { ++mismatches; break; }
+            }
+            ++checks;
+         }
+      }
+   }
+
+   double per_repair = t_repair / ( (double) updates * trees );
+   printf( "airports: %d, routes: %d, trees: %d, updates: %d\n", csr->len, csr->edges, trees, updates );
+   printf( "full recompute:  %10.3f us per tree\n", t_full * 1e6 );
+   printf( "repair:          %10.3f us per tree and update (%.0fx faster)\n", per_repair * 1e6, t_full / per_repair );
+   printf( "trees changed by an update: %.2f%%, vertices re-settled per changed tree: %.1f\n",
+         100.0 * touched_trees / ( (double) updates * trees ), touched_trees ? (double) settled / touched_trees : 0.0 );
+   printf( "verification: %d trees checked, %d mismatches\n", checks, mismatches );
+
+   for( int t = 0; t < trees; ++t ) PathScratch_Free( &tree[ t ] );
+   PathScratch_Free( &check );
+   CSR_Delete( &csr );
+   free( tree ); free( roots ); free( edge_src ); free( base ); free( delayed );
+   free( lat ); free( lon ); free( src ); free( dst ); free( w );
+   return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Benchmark: rendimiento (MB/s) del reporte del grafo. Compara el reporte de
+ * texto de antes (un printf() por vecino) contra Report_Write() en texto, CSV y
+ * JSON con 1 a |max_hilos| hilos, y revisa que el texto sea idéntico.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/report_bench.c Report.c Graph.c List.c StrPool.c -lm -o report_bench
+ *
+ * Uso: ./report_bench [num_aeropuertos] [rutas_por_aeropuerto] [max_hilos] [archivo_salida]
+ *
+ * Por omisión la salida va a /dev/null, así que se mide el formateo; con un
+ * archivo se mide también la escritura.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "Report.h"
+#include "bench.h"
+
+// el Graph_Print() anterior: printf() con formato por cada aeropuerto y por cada vecino
+static void print_stdio( const Graph* g, FILE* out )
+{
+   for( int i = 0; i < g->len; ++i )
+   {
+      const Vertex* vertex = &g->vertices[ i ];
+      if( vertex->removed ) continue;
+
+      if( vertex->neighbors )
+      {
+         fprintf( out, "[%d]Los aviones en el aeropuerto con id %d con tiempo UTC= %d con código IATA %s del país %s de la ciudad %s con el nombre de %s ",
+                  i, g->ids[ i ], g->utc_times[ i ], g->iata_codes[ i ], Graph_GetCountry( g, i ), Graph_GetCity( g, i ), Graph_GetName( g, i ) );
+         fprintf( out, "puede ir a " );
+
+         for( List_Iterator it = Vertex_Begin( vertex ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+         {
+            Edge e = List_Iterator_get( it );
+            if( Graph_IsRemoved( g, e.index ) ) continue;
+
+            fprintf( out, "el aeropuerto con IATA %s con un tiempo de %0.2f, ", g->iata_codes[ e.index ], e.weight );
+         }
+      }
+      fprintf( out, "\n" );
+   }
+   fprintf( out, "\n" );
+}
+
+static void report( const char* what, int threads, double seconds, long bytes )
+{
+   printf( "%-6s %2d hilo(s): %8.1f MB en %7.3f s = %8.1f MB/s\n",
+           what, threads, bytes / 1e6, seconds, bytes / 1e6 / seconds );
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports    = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+   int per         = argc > 2 ? atoi( argv[ 2 ] ) : 8;
+   int max_threads = argc > 3 ? atoi( argv[ 3 ] ) : 4;
+   const char* path = argc > 4 ? argv[ 4 ] : "/dev/null";
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   if( !g ) return 1;
+
+   srand( 42 );
+   char code[ 4 ], country[ 32 ], city[ 32 ], name[ 64 ];
+   for( int i = 0; i < airports; ++i )
+   {
+      int k = i % ( 26 * 26 * 26 );
+      code[ 0 ] = 'A' + k / ( 26 * 26 );
+      code[ 1 ] = 'A' + k / 26 % 26;
+      code[ 2 ] = 'A' + k % 26;
+      code[ 3 ] = '\0';
+      snprintf( country, sizeof( country ), "Country %d", i % 230 );
+      snprintf( city, sizeof( city ), "City %d", i % ( airports / 3 + 1 ) );
+      snprintf( name, sizeof( name ), "International Airport \"%d\", Terminal %d", i, i % 5 );
+
+      Graph_AddVertex( g, i + 1, code, country, city, name, i % 25 - 12 );
+      Graph_SetLocation( g, i + 1, ( rand() % 180000 ) / 1000.0f - 90.0f, ( rand() % 360000 ) / 1000.0f - 180.0f );
+   }
+   for( long i = 0; i < (long) airports * per; ++i )
+   {
+      Graph_AddWeightedEdge( g, rand() % airports + 1, rand() % airports + 1, ( rand() % 100000 ) / 100.0f );
+   }
+
+   // primero se revisa que el texto sea idéntico al de printf()
+   char* expected = NULL;
+   char* actual = NULL;
+   size_t expected_len = 0, actual_len = 0;
+
+   FILE* mem = open_memstream( &expected, &expected_len );
+   print_stdio( g, mem );
+   fclose( mem );
+
+   mem = open_memstream( &actual, &actual_len );
+   Report_Write( g, eReportFormat_TEXT, mem, max_threads );
+   fclose( mem );
+
+   printf( "%d aeropuertos, %d rutas por aeropuerto; texto %s\n", airports, per,
+           expected_len == actual_len && memcmp( expected, actual, actual_len ) == 0 ? "idéntico" : "DIFERENTE" );
+   free( expected );
+   free( actual );
+
+   FILE* out = fopen( path, "w" );
+   if( !out ) return 1;
+
+   double t0 = now();
+   print_stdio( g, out );
+   fflush( out );
+   report( "printf", 1, now() - t0, ftell( out ) > 0 ? ftell( out ) : (long) expected_len );
+
+   static const char* names[] = { "texto", "csv", "json" };
+   for( int format = eReportFormat_TEXT; format <= eReportFormat_JSON; ++format )
+   {
+      for( int threads = 1; threads <= max_threads; threads *= 2 )
+      {
+         rewind( out );
+         double t1 = now();
+         long bytes = Report_Write( g, (eReportFormat) format, out, threads );
+         fflush( out );
+         double t2 = now();
+
+         if( bytes < 0 ) return 1;
+         report( names[ format ], threads, t2 - t1, bytes );
+      }
+   }
+
+   fclose( out );
+   Graph_Delete( &g );
+   return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * Generador de carga para el modo servidor: crea una red sintética con
+ * códigos IATA, genera una mezcla de consultas N/R/P y mide cuántas consultas
+ * por segundo contesta Server_AnswerBatch() con 1, 2, 4, ... y |max_hilos|
+ * hilos. Las respuestas con un hilo se revisan contra una búsqueda en amplitud
+ * y las demás deben coincidir con ellas.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/server_bench.c Server.c Cache.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o server_bench
+ *
+ * Uso: ./server_bench [num_aeropuertos] [num_consultas] [max_hilos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "Server.h"
+#include "bench.h"
+
+// saltos mínimos desde |src| a todos los vértices (-1 si no se alcanzan)
+static void bfs_hops( const CSR* csr, int src, int hops[], int queue[] )
+{
+   for( int v = 0; v < csr->len; ++v ) hops[ v ] = -1;
+
+   int head = 0, tail = 0;
+   hops[ src ] = 0;
+   queue[ tail++ ] = src;
+   while( head < tail )
+   {
+      int u = queue[ head++ ];
+      for( int k = csr->offsets[ u ]; k < csr->offsets[ u + 1 ]; ++k )
+      {
+         int v = csr->targets[ k ];
+         if( hops[ v ] == -1 )
+         {
+            hops[ v ] = hops[ u ] + 1;
+            queue[ tail++ ] = v;
+         }
+      }
+   }
+}
+
+// revisa la respuesta contra una búsqueda en amplitud: N da tantos vecinos como
+// el grado; R contesta "yes" sólo si hay camino; P contesta "none" sólo si no
+// hay camino y, si lo hay, va de a a b con al menos los saltos mínimos
+static bool check_answer( const CSR* csr, const char* line, const char* answer, int hops[] )
+{
+   char kind, a[ 4 ], b[ 4 ] = "";
+   if( sscanf( line, "%c %3s %3s", &kind, a, b ) < 2 ) return false;
+
+   int src = CSR_GetIndexByIata( csr, a );
+   if( src == -1 ) return false;
+
+   if( kind == 'N' )
+   {
+      int tokens = 0;
+      for( const char* p = answer; *p; ++p ) tokens += *p == ' ';
+      return tokens == 2 * CSR_Degree( csr, src ) || strstr( answer, "..." ) != NULL;
+   }
+
+   int dst = CSR_GetIndexByIata( csr, b );
+   if( dst == -1 ) return false;
+
+   int* queue = hops + csr->len;
+   bfs_hops( csr, src, hops, queue );
+   bool reachable = hops[ dst ] != -1;
+
+   if( kind == 'R' ) return strcmp( answer, reachable ? "yes\n" : "no\n" ) == 0;
+
+   if( !reachable ) return strcmp( answer, "none\n" ) == 0;
+
+   int codes = 0;
+   char first[ 4 ] = "", last[ 4 ] = "";
+   for( const char* p = strchr( answer, ' ' ); p; p = strchr( p + 1, ' ' ) )
+   {
+      if( sscanf( p + 1, "%3s", last ) != 1 ) return false;
+      if( codes++ == 0 ) memcpy( first, last, sizeof( first ) );
+   }
+   if( strstr( answer, "..." ) ) return true;
+   // respuesta truncada: no se puede revisar el camino completo
+
+   return strcmp( first, a ) == 0 && strcmp( last, b ) == 0 && codes - 1 >= hops[ dst ];
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 10000;
+   int queries  = argc > 2 ? atoi( argv[ 2 ] ) : 20000;
+   int max_threads = argc > 3 ? atoi( argv[ 3 ] ) : (int) sysconf( _SC_NPROCESSORS_ONLN );
+
+   if( airports > IATA_INDEX_SIZE ) airports = IATA_INDEX_SIZE;
+   if( max_threads < 1 ) max_threads = 1;
+
+   srand( 42 );
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   assert( g );
+   for( int i = 0; i < airports; ++i )
+   {
+      int k = (int)( ( i * 7919L ) % IATA_INDEX_SIZE );
+      char code[ 4 ] = { 'A' + k / 676, 'A' + k / 26 % 26, 'A' + k % 26, '\0' };
+      Graph_AddVertex( g, i, code, "", "", "", 0 );
+   }
+   for( long e = 0; e < (long) airports * 8; ++e )
+   {
+      Graph_AddWeightedEdge( g, rand() % airports, rand() % airports, 0.5f + ( rand() % 120 ) / 10.0f );
+   }
+
+   CSR* csr = Graph_Freeze( g );
+   assert( csr );
+
+   int* hops = malloc( 2 * csr->len * sizeof( int ) );
+   // |hops| y la cola de la búsqueda de check_answer()
+   assert( hops );
+
+   // mezcla: 40% vecinos, 30% alcanzabilidad, 30% itinerario
+   char ( *text )[ 16 ] = malloc( queries * sizeof( *text ) );
+   const char** lines = malloc( queries * sizeof( char* ) );
+   for( int q = 0; q < queries; ++q )
+   {
+      int r = rand() % 10;
+      const char* a = Graph_GetIata( g, rand() % airports );
+      const char* b = Graph_GetIata( g, rand() % airports );
+
+      if( r < 4 ) snprintf( text[ q ], 16, "N %s", a );
+      else snprintf( text[ q ], 16, "%c %s %s", r < 7 ? 'R' : 'P', a, b );
+      lines[ q ] = text[ q ];
+   }
+
+   char ( *out )[ SERVER_LINE_MAX ] = malloc( (size_t) queries * sizeof( *out ) );
+   char ( *first )[ SERVER_LINE_MAX ] = malloc( (size_t) queries * sizeof( *first ) );
+   assert( out && first );
+
+   printf( "airports: %d, edges: %d, queries: %d\n", csr->len, csr->edges, queries );
+
+   double base = 0.0;
+   for( int threads = 1; ; threads = threads * 2 > max_threads && threads < max_threads ? max_threads : threads * 2 )
+   {
+      // 1, 2, 4, ... y al final siempre |max_threads|
+      Server* srv = Server_New( csr, threads );
+      assert( srv );
+
+      double t0 = now();
+      for( int q = 0; q < queries; q += SERVER_BATCH_MAX )
+      {
+         int count = queries - q < SERVER_BATCH_MAX ? queries - q : SERVER_BATCH_MAX;
+         Server_AnswerBatch( srv, lines + q, count, out + q );
+      }
+      double t = now() - t0;
+
+      int wrong = 0;
+      if( threads == 1 )
+      {
+         base = t;
+         for( int q = 0; q < queries; ++q ) wrong += !check_answer( csr, lines[ q ], out[ q ], hops );
+         memcpy( first, out, (size_t) queries * sizeof( *out ) );
+      }
+      else
+      {
+         // con varios hilos las respuestas deben ser las mismas que con uno
+         for( int q = 0; q < queries; ++q ) wrong += strcmp( first[ q ], out[ q ] ) != 0;
+      }
+
+      printf( "threads: %3d  %10.0f queries/s  (%.2fx)  %s\n", threads, queries / t, base / t,
+              wrong == 0 ? "ok" : "WRONG ANSWERS" );
+      if( wrong > 0 ) return 1;
+
+      Server_Delete( &srv );
+
+      if( threads == max_threads ) break;
+   }
+
+   free( first );
+   free( hops );
+   free( out );
+   free( lines );
+   free( text );
+   CSR_Delete( &csr );
+   Graph_Delete( &g );
+   return 0;
+}
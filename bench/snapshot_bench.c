@@ -0,0 +1,105 @@
+/*
+ * Benchmark: arranque desde una copia binaria contra volver a construir el grafo.
+ *
+ * Genera un grafo aleatorio, lo congela y lo guarda con Snapshot_Save(); luego
+ * mide cuánto tarda en estar listo para la primera consulta al abrirlo con
+ * Snapshot_Load() (con y sin verificación) y al reconstruirlo desde cero.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/snapshot_bench.c Snapshot.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o snapshot_bench
+ *
+ * Uso: ./snapshot_bench [num_aeropuertos] [num_rutas] [archivo]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Snapshot.h"
+#include "Path.h"
+#include "bench.h"
+
+static Graph* build( int airports, int routes, int* src, int* dst, float* w )
+{
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   char iata[ 4 ] = "AAA";
+   for( int i = 0; i < airports; ++i )
+   {
+      int k = i % ( 26 * 26 * 26 );
+      iata[ 0 ] = 'A' + k / 676; iata[ 1 ] = 'A' + k / 26 % 26; iata[ 2 ] = 'A' + k % 26;
+      Graph_AddVertex( g, i + 1, iata, "Country", "City", "Airport", 0 );
+   }
+   Graph_AddEdgesByIndex( g, src, dst, w, routes );
+   return g;
+}
+
+// la primera consulta es la que paga las páginas que todavía no están en memoria
+static double first_query( const CSR* csr, int* path )
+{
+   PathScratch s;
+   if( !PathScratch_Init( &s, csr->len ) ) return -1.0;
+
+   double t0 = now();
+   int path_len;
+   Path_Dijkstra( csr, 0, csr->len - 1, &s, path, csr->len, &path_len );
+   double t = now() - t0;
+
+   PathScratch_Free( &s );
+   return t;
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+   int routes   = argc > 2 ? atoi( argv[ 2 ] ) : 5000000;
+   const char* path = argc > 3 ? argv[ 3 ] : "/tmp/bench_snapshot.bin";
+
+   int* src = (int*) malloc( routes * sizeof( int ) );
+   int* dst = (int*) malloc( routes * sizeof( int ) );
+   float* w = (float*) malloc( routes * sizeof( float ) );
+   int* buf = (int*) malloc( airports * sizeof( int ) );
+   if( !src || !dst || !w || !buf ) return 1;
+
+   srand( 42 );
+   for( int i = 0; i < routes; ++i )
+   {
+      src[ i ] = rand() % airports;
+      dst[ i ] = rand() % airports;
+      w[ i ] = 1.0f + rand() % 1000 / 100.0f;
+   }
+
+   // reconstruir: crear el grafo y congelarlo (sin contar la lectura del texto, ver loader_bench)
+   double t0 = now();
+   Graph* g = build( airports, routes, src, dst, w );
+   CSR* csr = Graph_Freeze( g );
+   double t_build = now() - t0;
+   if( !csr ) return 1;
+   double q_build = first_query( csr, buf );
+
+   t0 = now();
+   bool ok = Snapshot_Save( csr, path );
+   double t_save = now() - t0;
+   if( !ok ) return 1;
+
+   printf( "airports: %d, edges: %d\n", csr->len, csr->edges );
+   printf( "rebuild + freeze:       %8.3f ms, first query %8.3f ms\n", t_build * 1e3, q_build * 1e3 );
+   printf( "save:                   %8.3f ms\n", t_save * 1e3 );
+
+   CSR_Delete( &csr );
+   Graph_Delete( &g );
+
+   for( int verify = 0; verify <= 1; ++verify )
+   {
+      t0 = now();
+      CSR* snap = Snapshot_Load( path, verify );
+      double t_load = now() - t0;
+      if( !snap ) return 1;
+      double q = first_query( snap, buf );
+
+      printf( "load (%s):      %8.3f ms, first query %8.3f ms\n", verify ? "verify   " : "no verify", t_load * 1e3, q * 1e3 );
+      CSR_Delete( &snap );
+   }
+
+   remove( path );
+   free( src ); free( dst ); free( w ); free( buf );
+   return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Benchmark: consultas de llegada más temprana (Timetable_EarliestArrival())
+ * sobre un itinerario diario completo.
+ *
+ * Genera aeropuertos en husos horarios aleatorios, rutas entre ellos y de 1 a 6
+ * salidas diarias por ruta (en hora local), y contesta consultas aleatorias.
+ * Una parte de las consultas se compara contra una relajación ingenua de todos
+ * los vuelos hasta que nada cambie.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -pthread -I. bench/timetable_bench.c Timetable.c Path.c CSR.c Graph.c Report.c List.c StrPool.c -lm -o timetable_bench
+ *
+ * Uso: ./timetable_bench [num_aeropuertos] [num_rutas] [num_consultas]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "Timetable.h"
+#include "Path.h"
+#include "bench.h"
+
+static int cmp_double( const void* a, const void* b )
+{
+   double x = *(const double*) a, y = *(const double*) b;
+   return x < y ? -1 : x > y;
+}
+
+// relaja todos los vuelos de la ventana de la consulta hasta que nada cambie
+static int naive( const Timetable* tt, int src, int dst, int departure, int* arrival )
+{
+   for( int v = 0; v < tt->csr->len; ++v ) arrival[ v ] = INT_MAX;
+   arrival[ src ] = departure;
+
+   int first_day = departure / TIMETABLE_DAY;
+   int end = ( first_day + TIMETABLE_MAX_DAYS + 1 ) * TIMETABLE_DAY;
+
+   for( bool changed = true; changed; )
+   {
+      changed = false;
+      for( int d = first_day; d <= first_day + TIMETABLE_MAX_DAYS; ++d )
+      {
+         for( int i = 0; i < tt->count; ++i )
+         {
+            const Connection* c = &tt->conns[ i ];
+            int dep = d * TIMETABLE_DAY + c->departure;
+            if( dep < departure || dep >= end || arrival[ c->from ] == INT_MAX ) continue;
+
+            int ready = arrival[ c->from ] + ( c->from != src ? TIMETABLE_MIN_CONNECTION : 0 );
+            if( ready <= dep && dep + c->duration < arrival[ c->to ] )
+            {
+               arrival[ c->to ] = dep + c->duration;
+               changed = true;
+            }
+         }
+      }
+   }
+   return arrival[ dst ] == INT_MAX ? -1 : arrival[ dst ];
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 7000;
+   int routes   = argc > 2 ? atoi( argv[ 2 ] ) : 60000;
+   int queries  = argc > 3 ? atoi( argv[ 3 ] ) : 10000;
+   const int checked = 50;
+
+   srand( 42 );
+
+   Graph* g = Graph_New( airports, eGraphType_DIRECTED );
+   for( int i = 0; i < airports; ++i )
+   {
+      Graph_AddVertex( g, i + 1, "", "", "", "", rand() % 27 - 12 );
+      Graph_SetLocation( g, i + 1, -60.0f + 120.0f * rand() / RAND_MAX, -180.0f + 360.0f * rand() / RAND_MAX );
+   }
+   CSR* csr = Graph_Freeze( g );
+   Graph_Delete( &g );
+
+   Timetable* tt = csr ? Timetable_New( csr ) : NULL;
+   if( !tt ) return 1;
+
+   for( int r = 0; r < routes; ++r )
+   {
+      int a = rand() % airports, b = rand() % airports;
+      if( a == b ) continue;
+
+      float km = Path_DistanceKm( csr->latitude[ a ], csr->longitude[ a ], csr->latitude[ b ], csr->longitude[ b ] );
+      int duration = (int)( km / 800.0f * 60.0f ) + 30;
+
+      for( int f = 1 + rand() % 6; f > 0; --f ) Timetable_AddFlight( tt, a, b, rand() % TIMETABLE_DAY, duration );
+   }
+
+   double t0 = now();
+   if( !Timetable_Sort( tt ) ) return 1;
+   double t_sort = now() - t0;
+
+   TimetableScratch s;
+   int* arrival = (int*) malloc( airports * sizeof( int ) );
+   double* lat = (double*) malloc( queries * sizeof( double ) );
+   TimetableLeg legs[ 64 ];
+   if( !arrival || !lat || !TimetableScratch_Init( &s, airports ) ) return 1;
+
+   int reached = 0, mismatches = 0;
+   long scanned = 0;
+   double total = 0.0;
+   for( int q = 0; q < queries; ++q )
+   {
+      int src = rand() % airports, dst = rand() % airports;
+      int departure = rand() % TIMETABLE_DAY;
+      int legs_len;
+
+      t0 = now();
+      int arr = Timetable_EarliestArrival( tt, src, dst, departure, &s, legs, 64, &legs_len );
+      lat[ q ] = now() - t0;
+      total += lat[ q ];
+
+      scanned += s.scanned;
+      if( arr != -1 ) ++reached;
+      if( q < checked && naive( tt, src, dst, departure, arrival ) != arr ) ++mismatches;
+   }
+   qsort( lat, queries, sizeof( double ), cmp_double );
+
+   printf( "airports: %d, flights per day: %d (sort %.2f ms)\n", airports, tt->count, t_sort * 1e3 );
+   printf( "queries: %d, reachable: %d, flights scanned per query: %ld\n", queries, reached, scanned / queries );
+   printf( "latency: mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+         total / queries * 1e3, lat[ queries / 2 ] * 1e3, lat[ queries * 99 / 100 ] * 1e3, lat[ queries - 1 ] * 1e3 );
+   printf( "checked against naive relaxation: %d queries, %d mismatches\n", checked, mismatches );
+
+   TimetableScratch_Free( &s );
+   Timetable_Delete( &tt );
+   CSR_Delete( &csr );
+   free( arrival );
+   free( lat );
+   return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Benchmark: adyacencia ordenada en una red con hubs (los extremos de las rutas
+ * siguen una distribución de Zipf). Compara, antes y después de CSR_Sort():
+ *
+ *    - pertenencia: recorrer el renglón contra CSR_HasEdge() por bisección;
+ *    - vecinos comunes: marcar los vecinos de u y recorrer los de v contra
+ *      CSR_CommonNeighbors();
+ *    - triángulos: el mismo marcado por cada vértice contra Triangles_Count().
+ *
+ * Revisa que las respuestas coincidan.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -march=native -pthread -I. bench/triangle_bench.c CSR.c Triangles.c Graph.c Report.c List.c StrPool.c -lm -o triangle_bench
+ *
+ * Uso: ./triangle_bench [num_aeropuertos] [rutas_por_aeropuerto] [num_consultas]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "Graph.h"
+#include "CSR.h"
+#include "Triangles.h"
+#include "bench.h"
+
+static bool has_edge_scan( const CSR* csr, int u, int v )
+{
+   const int* row = CSR_Neighbors( csr, u );
+   for( int k = 0; k < CSR_Degree( csr, u ); ++k )
+   {
+      if( row[ k ] == v ) return true;
+   }
+   return false;
+}
+
+// vecinos comunes con un arreglo de marcas (no necesita orden)
+static int common_marks( const CSR* csr, int u, int v, int mark[], int stamp )
+{
+   const int* nu = CSR_Neighbors( csr, u );
+   for( int k = 0; k < CSR_Degree( csr, u ); ++k ) mark[ nu[ k ] ] = stamp;
+
+   int c = 0;
+   const int* nv = CSR_Neighbors( csr, v );
+   for( int k = 0; k < CSR_Degree( csr, v ); ++k ) c += mark[ nv[ k ] ] == stamp;
+   return c;
+}
+
+// triángulos u < v < w con marcas: para cada u se marcan sus vecinos y se
+// recorren los vecinos de cada vecino
+static long triangles_marks( const CSR* csr, int mark[] )
+{
+   long total = 0;
+   for( int u = 0; u < csr->len; ++u )
+   {
+      const int* nu = CSR_Neighbors( csr, u );
+      int du = CSR_Degree( csr, u );
+      for( int k = 0; k < du; ++k ) mark[ nu[ k ] ] = -( u + 1 );
+
+      for( int k = 0; k < du; ++k )
+      {
+         int v = nu[ k ];
+         if( v <= u ) continue;
+
+         const int* nv = CSR_Neighbors( csr, v );
+         for( int t = 0; t < CSR_Degree( csr, v ); ++t ) total += nv[ t ] > v && mark[ nv[ t ] ] == -( u + 1 );
+      }
+   }
+   return total;
+}
+
+int main( int argc, char* argv[] )
+{
+   int airports = argc > 1 ? atoi( argv[ 1 ] ) : 100000;
+   int per      = argc > 2 ? atoi( argv[ 2 ] ) : 10;
+   int queries  = argc > 3 ? atoi( argv[ 3 ] ) : 200000;
+
+   Graph* g = Graph_New( airports, eGraphType_UNDIRECTED );
+   int* src = (int*) malloc( queries * sizeof( int ) );
+   int* dst = (int*) malloc( queries * sizeof( int ) );
+   int* mark = (int*) calloc( airports, sizeof( int ) );
+   if( !g || !src || !dst || !mark ) return 1;
+
+   srand( 42 );
+   for( int i = 0; i < airports; ++i ) Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+   for( long i = 0; i < (long) airports * per; ++i )
+   {
+      Graph_AddWeightedEdge( g, zipf( airports ) + 1, zipf( airports ) + 1, 60.0f );
+   }
+
+   CSR* csr = Graph_Freeze( g );
+   if( !csr ) return 1;
+
+   int max_degree = 0;
+   for( int v = 0; v < csr->len; ++v ) if( CSR_Degree( csr, v ) > max_degree ) max_degree = CSR_Degree( csr, v );
+
+   printf( "%d aeropuertos, %d aristas (cuentan ambos sentidos), grado máximo %d, %d consultas\n",
+           airports, csr->edges, max_degree, queries );
+
+   for( int i = 0; i < queries; ++i )
+   {
+      src[ i ] = zipf( airports );
+      dst[ i ] = zipf( airports );
+   }
+
+   // pertenencia
+   double t0 = now();
+   int found_scan = 0;
+   for( int i = 0; i < queries; ++i ) found_scan += has_edge_scan( csr, src[ i ], dst[ i ] );
+   double t1 = now();
+
+   double ts = now();
+   if( !CSR_Sort( csr ) ) return 1;
+   double sort_ms = ( now() - ts ) * 1e3;
+
+   double t2 = now();
+   int found_sorted = 0;
+   for( int i = 0; i < queries; ++i ) found_sorted += CSR_HasEdge( csr, src[ i ], dst[ i ] );
+   double t3 = now();
+
+   printf( "CSR_Sort(): %.1f ms\n", sort_ms );
+   printf( "%-18s %14s %14s %10s %8s\n", "", "marcas/recorr.", "ordenado", "aceleración", "iguales" );
+   printf( "%-18s %11.1f ns %11.1f ns %10.2fx %8s\n", "pertenencia",
+           ( t1 - t0 ) * 1e9 / queries, ( t3 - t2 ) * 1e9 / queries, ( t1 - t0 ) / ( t3 - t2 ),
+           found_scan == found_sorted ? "sí" : "NO" );
+
+   // vecinos comunes
+   t0 = now();
+   long common_a = 0;
+   for( int i = 0; i < queries; ++i ) common_a += common_marks( csr, src[ i ], dst[ i ], mark, i + 1 );
+   t1 = now();
+   long common_b = 0;
+   for( int i = 0; i < queries; ++i ) common_b += CSR_CommonNeighbors( csr, src[ i ], dst[ i ], NULL );
+   t2 = now();
+
+   printf( "%-18s %11.1f ns %11.1f ns %10.2fx %8s\n", "vecinos comunes",
+           ( t1 - t0 ) * 1e9 / queries, ( t2 - t1 ) * 1e9 / queries, ( t1 - t0 ) / ( t2 - t1 ),
+           common_a == common_b ? "sí" : "NO" );
+
+   // triángulos
+   for( int v = 0; v < airports; ++v ) mark[ v ] = 0;
+   t0 = now();
+   long tri_a = triangles_marks( csr, mark );
+   t1 = now();
+   long tri_b = Triangles_Count( csr );
+   t2 = now();
+
+   printf( "%-18s %11.1f ms %11.1f ms %10.2fx %8s\n", "triángulos",
+           ( t1 - t0 ) * 1e3, ( t2 - t1 ) * 1e3, ( t1 - t0 ) / ( t2 - t1 ),
+           tri_a == tri_b ? "sí" : "NO" );
+   printf( "%ld triángulos; el hub 0 está en %ld\n", tri_b, Triangles_CountAt( csr, 0 ) );
+
+   CSR_Delete( &csr );
+   Graph_Delete( &g );
+   free( src );
+   free( dst );
+   free( mark );
+   return 0;
+}
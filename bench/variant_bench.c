@@ -0,0 +1,154 @@
+/*
+ * Benchmark: tamaño y velocidad de las variantes especializadas del grafo
+ * (GraphSpec.h) contra Graph, que decide el tipo en tiempo de ejecución y
+ * guarda siempre el peso. Para cada una mide los bytes por arista en el heap,
+ * el tiempo por inserción y el tiempo por arista de un recorrido completo de
+ * la adyacencia. Las inserciones en Graph van por id (incluyen la búsqueda en
+ * el índice de ids); las de las variantes, por índice.
+ *
+ * Compilar desde la raíz del repositorio:
+ *    gcc -O2 -march=native -pthread -I. bench/variant_bench.c GraphSpec.c Graph.c Report.c List.c StrPool.c -lm -o variant_bench
+ *
+ * Uso: ./variant_bench [num_vertices] [aristas_por_vertice] [recorridos]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <malloc.h>
+#include <math.h>
+
+#include "Graph.h"
+#include "GraphSpec.h"
+#include "bench.h"
+
+// bytes ocupados en el heap (incluye los bloques grandes, que van con mmap())
+static double heap_bytes( void )
+{
+   struct mallinfo2 mi = mallinfo2();
+   return (double) mi.uordblks + (double) mi.hblkhd;
+}
+
+static void report( const char* name, double bytes, long edges, double insert, double traverse, int passes, double check )
+{
+   printf( "%-22s %10ld %12.1f %12.1f %12.2f %14.0f\n", name, edges, bytes / edges,
+           insert * 1e9 / edges, traverse * 1e9 / ( (double) edges * passes ), check );
+}
+
+static int n;
+static long m;
+static int* src;
+static int* dst;
+static float* wgt;
+static int passes;
+
+static void bench_graph( eGraphType type, bool weighted )
+{
+   double h0 = heap_bytes();
+   double t0 = now();
+
+   Graph* g = Graph_New( n, type );
+   for( int i = 0; i < n; ++i ) Graph_AddVertex( g, i + 1, "", "", "", "", 0 );
+   for( long i = 0; i < m; ++i )
+   {
+      if( weighted ) Graph_AddWeightedEdge( g, src[ i ] + 1, dst[ i ] + 1, wgt[ i ] );
+      else Graph_AddEdge( g, src[ i ] + 1, dst[ i ] + 1 );
+   }
+
+   double t1 = now();
+   double bytes = heap_bytes() - h0;
+
+   long edges = 0;
+   double check = 0.0;
+   for( int p = 0; p < passes; ++p )
+   {
+      edges = 0;
+      for( int v = 0; v < g->len; ++v )
+      {
+         for( List_Iterator it = Vertex_Begin( &g->vertices[ v ] ); !List_Iterator_end( it ); List_Iterator_next( &it ) )
+         {
+            Edge e = List_Iterator_get( it );
+            check += weighted ? e.weight : e.index;
+            ++edges;
+         }
+      }
+   }
+   double t2 = now();
+
+   char name[ 32 ];
+   snprintf( name, sizeof( name ), "Graph (%s%s)", type == eGraphType_DIRECTED ? "dir." : "no dir.", weighted ? ", peso" : "" );
+   report( name, bytes, edges, t1 - t0, t2 - t1, passes, check );
+
+   Graph_Delete( &g );
+}
+
+// mide la variante |T|; WEIGHTED es 0 o 1
+#define BENCH_SPEC( T, WEIGHTED )                                                         \
+   do                                                                                     \
+   {                                                                                      \
+      double h0 = heap_bytes();                                                           \
+      double t0 = now();                                                                  \
+                                                                                          \
+      T* g = T##_New( n );                                                                \
+      for( int i = 0; i < n; ++i ) T##_AddVertex( g );                                    \
+      for( long i = 0; i < m; ++i ) T##_AddEdge( g, src[ i ], dst[ i ] GRAPH_SPEC_IF( WEIGHTED, , wgt[ i ] ) ); \
+                                                                                          \
+      double t1 = now();                                                                  \
+      double bytes = heap_bytes() - h0;                                                   \
+                                                                                          \
+      double check = 0.0;                                                                 \
+      for( int p = 0; p < passes; ++p )                                                   \
+      {                                                                                   \
+         for( int v = 0; v < g->len; ++v )                                                \
+         {                                                                                \
+            const int* nbrs = T##_Neighbors( g, v );                                      \
+            GRAPH_SPEC_IF( WEIGHTED, const float* w = T##_Weights( g, v ); )              \
+            for( int k = 0; k < T##_Degree( g, v ); ++k )                                 \
+            {                                                                             \
+               GRAPH_SPEC_IF( WEIGHTED, check += w[ k ]; )                                \
+               if( !WEIGHTED ) check += nbrs[ k ];                                        \
+            }                                                                             \
+         }                                                                                \
+      }                                                                                   \
+      double t2 = now();                                                                  \
+                                                                                          \
+      report( #T, bytes, g->edges, t1 - t0, t2 - t1, passes, check );                     \
+      T##_Delete( &g );                                                                   \
+   } while( 0 )
+
+int main( int argc, char* argv[] )
+{
+   n      = argc > 1 ? atoi( argv[ 1 ] ) : 200000;
+   int per = argc > 2 ? atoi( argv[ 2 ] ) : 10;
+   passes = argc > 3 ? atoi( argv[ 3 ] ) : 5;
+   m = (long) n * per;
+
+   src = (int*) malloc( m * sizeof( int ) );
+   dst = (int*) malloc( m * sizeof( int ) );
+   wgt = (float*) malloc( m * sizeof( float ) );
+   if( !src || !dst || !wgt ) return 1;
+
+   srand( 42 );
+   for( long i = 0; i < m; ++i )
+   {
+      src[ i ] = zipf( n );
+      dst[ i ] = rand() % n;
+      wgt[ i ] = ( rand() % 100000 ) / 100.0f;
+   }
+
+   printf( "%d vértices, %ld aristas insertadas, %d recorridos\n", n, m, passes );
+   printf( "%-22s %10s %12s %12s %12s %14s\n", "", "aristas", "bytes/arista", "ns/inserción", "ns/arista rec.", "suma" );
+
+   bench_graph( eGraphType_UNDIRECTED, false );
+   BENCH_SPEC( UGraph, 0 );
+   bench_graph( eGraphType_UNDIRECTED, true );
+   BENCH_SPEC( UGraphW, 1 );
+   bench_graph( eGraphType_DIRECTED, false );
+   BENCH_SPEC( DiGraph, 0 );
+   bench_graph( eGraphType_DIRECTED, true );
+   BENCH_SPEC( DiGraphW, 1 );
+
+   free( src );
+   free( dst );
+   free( wgt );
+   return 0;
+}